@@ -21,11 +21,189 @@
 #include <string_view>
 #include <charconv>
 #include <numeric>
+#include <unordered_map>
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <list>
+#include <future>
+#include <map>
+#include <unordered_set>
+#include <typeinfo>
+#include <typeindex>
+#include <iomanip>
+#include <span>
+#include <bit>
+#include <cstring>
+#include <cmath>
+#include <stdexcept>
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/inotify.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+#if defined(_M_X64) || defined(__SSSE3__)
+#include <immintrin.h>
+#define USE_SSSE3
+#endif
+
+//!< R\[o͐ (񏈗̓Wũobt@֍ւ)
+namespace Console
+{
+	static thread_local std::ostream* OutStream = &std::cout;
+	static thread_local std::ostream* ErrStream = &std::cerr;
+	static std::ostream& Out() { return *OutStream; }
+	static std::ostream& Err() { return *ErrStream; }
+}
+
+//!< Wuŕɏۂ̃Xbh (--jobs ̃[J[Ńn[hEFAXbh𕪂)
+namespace Parallel
+{
+	static std::atomic<uint32_t> WorkerCount = 1; //!< ɏĂWu̐
+	static uint32_t GetThreadCount() { return (std::max)(std::thread::hardware_concurrency() / (std::max)(WorkerCount.load(), 1u), 1u); }
+}
+
+//!< XR[v𔲂鎞 (O܂)  Func Ă
+template<typename T>
+class ScopeExit
+{
+public:
+	ScopeExit(T Fn) : Func(std::move(Fn)) {}
+	~ScopeExit() { Func(); }
+	ScopeExit(const ScopeExit&) = delete;
+	ScopeExit& operator=(const ScopeExit&) = delete;
+private:
+	T Func;
+};
+
+//!< Ԃ̋L^ (--trace)AChrome ̃g[XCxg` (Perfetto ŊJ) ŏo
+//!<  Scope tO 1 ǂނ (OgݗĂꍇ͊֐œnA͌Ă΂Ȃ)
+namespace Trace
+{
+	using Clock = std::chrono::steady_clock;
+	struct Event
+	{
+		std::string Name;
+		std::string_view Category;
+		double Begin; //!< }CNb
+		double Duration;
+		uint32_t ThreadId;
+	};
+	static std::atomic<bool> Enabled = false;
+	static std::string Path;
+	static const auto Origin = Clock::now();
+	static std::mutex Mutex;
+	static std::vector<Event> Events;
+	static std::map<uint32_t, std::string> ThreadNames;
+
+	static uint32_t GetThreadId() {
+		static std::atomic<uint32_t> Count = 0;
+		static thread_local const auto Id = Count++;
+		return Id;
+	}
+	//!< OԂ֐ (͌Ă΂Ȃ)
+	template<typename T>
+	concept NameFunc = std::is_invocable_r_v<std::string, T>;
+
+	template<NameFunc T>
+	static void SetThreadName(const T& GetName) {
+		if (!Enabled.load(std::memory_order_relaxed)) { return; }
+		auto Name = GetName();
+		std::lock_guard Lock(Mutex);
+		ThreadNames[GetThreadId()] = std::move(Name);
+	}
+	static void SetThreadName(std::string_view Name) { SetThreadName([&]() { return std::string(Name); }); }
+	//!< ǂݍݎɃ\[XtH_ֈړ̂ŁApX͐΃pXɂĂ
+	static void Enable(std::string_view File) {
+		Path = std::filesystem::absolute(File).string();
+		Enabled = true;
+		SetThreadName("main");
+	}
+	//!< ܂ł̋L^̂Ă (--watch ł͍XVɁẢ̋L^o)
+	static void Reset() {
+		if (!Enabled.load(std::memory_order_relaxed)) { return; }
+		std::lock_guard Lock(Mutex);
+		Events.clear();
+	}
+
+	class Scope
+	{
+	public:
+		Scope(std::string_view Name, std::string_view Category = "stage") : Scope([&]() { return std::string(Name); }, Category) {}
+		template<NameFunc T>
+		Scope(const T& GetName, std::string_view Category = "stage") {
+			if (Enabled.load(std::memory_order_relaxed)) {
+				Active = true;
+				Name = GetName();
+				this->Category = Category;
+				Begin = Clock::now();
+			}
+		}
+		~Scope() {
+			if (Active) {
+				const auto End = Clock::now();
+				const auto ToMicro = [](const Clock::duration& rhs) { return std::chrono::duration<double, std::micro>(rhs).count(); };
+				std::lock_guard Lock(Mutex);
+				Events.emplace_back(Event({ .Name = std::move(Name), .Category = Category, .Begin = ToMicro(Begin - Origin), .Duration = ToMicro(End - Begin), .ThreadId = GetThreadId() }));
+			}
+		}
+	private:
+		bool Active = false;
+		std::string Name;
+		std::string_view Category;
+		Clock::time_point Begin;
+	};
+
+	//!< ܂ł̋L^o (L̂)
+	static void Write() {
+		if (!Enabled.load(std::memory_order_relaxed)) { return; }
+		const auto Escape = [](std::string_view rhs) {
+			std::string Str;
+			for (auto c : rhs) {
+				if ('"' == c || '\\' == c) { Str += '\\'; Str += c; }
+				else if (0x20 > static_cast<uint8_t>(c)) { Str += ' '; }
+				else { Str += c; }
+			}
+			return Str;
+		};
+		std::stringstream SS;
+		SS << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		{
+			std::lock_guard Lock(Mutex);
+			for (const auto& [Id, Name] : ThreadNames) {
+				SS << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << Id << ",\"args\":{\"name\":\"" << Escape(Name) << "\"}},\n";
+			}
+			SS << std::fixed << std::setprecision(3);
+			for (auto i = 0; i < size(Events); ++i) {
+				const auto& E = Events[i];
+				SS << "{\"name\":\"" << Escape(E.Name) << "\",\"cat\":\"" << E.Category << "\",\"ph\":\"X\",\"ts\":" << E.Begin << ",\"dur\":" << E.Duration << ",\"pid\":1,\"tid\":" << E.ThreadId << "}" << (size(Events) - 1 > i ? "," : "") << "\n";
+			}
+		}
+		SS << "]}\n";
+		std::ofstream Out(Path, std::ios::out);
+		Out << SS.str();
+	}
+}
 
 namespace CV
 {
 	static void Preview(std::string_view Title, const cv::Mat Image)
 	{
+		//!< 񏈗ɃEChEɊJȂ悤
+		static std::mutex Mutex;
+		std::lock_guard Lock(Mutex);
 		cv::imshow(data(Title), Image);
 		cv::waitKey(0);
 		cv::destroyWindow(data(Title));
@@ -79,6 +257,692 @@ namespace CV
 	}
 }
 
+//!< Œ̃J[Ggԋ߂F̃CfbNXe[u
+//!< RGB e 6 rbg̃ZɁAẐǂňԋ߂FɂȂ蓾Gg () \ߋ߂Ă
+//!< 𑍓ƓArŒׂ̂Ōʂ͑ (FindLinear) ƈv
+template<size_t N>
+class NearestColorTable
+{
+public:
+	NearestColorTable(const std::array<cv::Vec3b, N>& Ents) : Entries(Ents) {
+		static_assert(N < 0xff);
+		Directs.reserve(CellCount);
+		Offsets.reserve(CellCount + 1);
+		std::vector<uint8_t> Cands;
+		for (uint32_t c = 0; c < CellCount; ++c) {
+			Offsets.emplace_back(static_cast<uint32_t>(size(Candidates)));
+
+			//!< Z͈̔ [Min, Max] (B, G, R)
+			std::array<int, 3> Min, Max;
+			for (auto k = 0; k < 3; ++k) {
+				Min[k] = ((c >> (k * CellBits)) & CellMask) << CellShift;
+				Max[k] = Min[k] + (1 << CellShift) - 1;
+			}
+
+			//!< Zł̊eGgւ̍ŏƁAő勗̍ŏl߂
+			std::array<int, N> MinDistSq;
+			auto Bound = (std::numeric_limits<int>::max)();
+			for (auto i = 0; i < N; ++i) {
+				auto DistSq = 0, FarSq = 0;
+				for (auto k = 0; k < 3; ++k) {
+					const int e = Entries[i][k];
+					const auto Near = e < Min[k] ? Min[k] - e : (e > Max[k] ? e - Max[k] : 0);
+					const auto Far = (std::max)(std::abs(e - Min[k]), std::abs(e - Max[k]));
+					DistSq += Near * Near;
+					FarSq += Far * Far;
+				}
+				MinDistSq[i] = DistSq;
+				Bound = (std::min)(Bound, FarSq);
+			}
+			//!< ŏ Bound 𒴂Gg̓Zňԋ߂FɂȂ蓾Ȃ
+			Cands.clear();
+			for (auto i = 0; i < N; ++i) {
+				if (MinDistSq[i] <= Bound) {
+					Cands.emplace_back(static_cast<uint8_t>(i));
+				}
+			}
+			//!< Z̑Ső̌ɕ̂͏
+			//!< (2 Fւ̋̍̓ZŐ`Ȃ̂ŁAZ 8 ŕΑSŕAȂCfbNX̎Ⴂ)
+			for (const auto e : Cands) {
+				const auto Lose = std::ranges::any_of(Cands, [&](const uint8_t a) {
+					if (a == e) { return false; }
+					for (auto k = 0; k < 8; ++k) {
+						const std::array<int, 3> Corner = { (k & 1) ? Max[0] : Min[0], (k & 2) ? Max[1] : Min[1], (k & 4) ? Max[2] : Min[2] };
+						const auto DistA = GetDistSq(Entries[a], Corner), DistE = GetDistSq(Entries[e], Corner);
+						if (DistA > DistE || (DistA == DistE && a > e)) { return false; }
+					}
+					return true;
+				});
+				if (!Lose) {
+					Candidates.emplace_back(e);
+				}
+			}
+			//!< ₪ 1 Ȃ炻ꂪ
+			Directs.emplace_back(1 == size(Candidates) - Offsets.back() ? Candidates.back() : 0xff);
+		}
+		Offsets.emplace_back(static_cast<uint32_t>(size(Candidates)));
+	}
+
+	uint8_t Find(const cv::Vec3b& Color) const {
+		const auto Cell = (Color[0] >> CellShift) | ((Color[1] >> CellShift) << CellBits) | ((Color[2] >> CellShift) << (CellBits << 1));
+		if (0xff != Directs[Cell]) { return Directs[Cell]; }
+
+		const auto B = Offsets[Cell], E = Offsets[Cell + 1];
+		//!< ̋ float ł덷\̂ŁAŔrĂʂ͕ςȂ
+		uint8_t Index = 0xff;
+		auto MinDistSq = (std::numeric_limits<int>::max)();
+		for (auto i = B; i < E; ++i) {
+			const auto DistSq = GetDistSq(Entries[Candidates[i]], { Color[0], Color[1], Color[2] });
+			if (DistSq < MinDistSq) {
+				MinDistSq = DistSq;
+				Index = Candidates[i];
+			}
+		}
+		return Index;
+	}
+
+	//!< 
+	static uint8_t FindLinear(const std::array<cv::Vec3b, N>& Entries, const cv::Vec3b& Color) {
+		uint8_t Index = 0xff;
+		float minDistSq = std::numeric_limits<float>::max();
+		for (auto i = 0; i < size(Entries); ++i) {
+			const auto d = cv::Vec3f(Entries[i]) - cv::Vec3f(Color);
+			const auto distSq = d.dot(d);
+			if (distSq < minDistSq) {
+				minDistSq = distSq;
+				Index = i;
+			}
+		}
+		return Index;
+	}
+
+private:
+	static int GetDistSq(const cv::Vec3b& Ent, const std::array<int, 3>& Color) {
+		const auto d0 = Ent[0] - Color[0], d1 = Ent[1] - Color[1], d2 = Ent[2] - Color[2];
+		return d0 * d0 + d1 * d1 + d2 * d2;
+	}
+
+	static constexpr uint32_t CellBits = 6;
+	static constexpr uint32_t CellShift = 8 - CellBits;
+	static constexpr uint32_t CellMask = (1 << CellBits) - 1;
+	static constexpr uint32_t CellCount = 1 << (CellBits * 3);
+
+	const std::array<cv::Vec3b, N>& Entries;
+	std::vector<uint8_t> Directs; //!< Z̓ (₪̏ꍇ 0xff)
+	std::vector<uint32_t> Offsets; //!< Ž̊Jnʒu
+	std::vector<uint8_t> Candidates;
+};
+
+//!< rbgv[
+namespace BitPlane
+{
+	//!< 1 s (Count = 8 or 16 sNZ) ̃J[CfbNX (+ Offset) Av[̃rbg (擪sNZ MSB) ɂ
+	//!< esNZ̊YrbgoCg MSB ֊񂹁Amovemask ł܂Ƃ߂ďW߂
+	template<uint32_t Count>
+	static std::array<uint16_t, 4> Gather(const uint8_t* Row, const uint32_t Offset) {
+		static_assert(8 == Count || 16 == Count);
+		std::array<uint16_t, 4> Planes;
+#ifdef USE_SSSE3
+		//!< KvȂ͉̂ 4 rbĝ
+		const auto Src = 16 == Count ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(Row)) : _mm_loadl_epi64(reinterpret_cast<const __m128i*>(Row));
+		const auto Indices = _mm_and_si128(_mm_add_epi8(Src, _mm_set1_epi8(static_cast<char>(Offset))), _mm_set1_epi8(0x0f));
+		//!< 擪sNZ MSB ƂȂ悤ɃoCg̕т𔽓]
+		const auto Reverse = 16 == Count ? _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0) : _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, -1, -1, -1, -1, -1, -1, -1, -1);
+		const auto Bytes = _mm_shuffle_epi8(Indices, Reverse);
+		for (auto pl = 0; pl < 4; ++pl) {
+			Planes[pl] = static_cast<uint16_t>(_mm_movemask_epi8(_mm_sll_epi16(Bytes, _mm_cvtsi32_si128(7 - pl))));
+		}
+#else
+		Planes.fill(0);
+		for (uint32_t j = 0; j < Count; ++j) {
+			const auto ColorIndex = Row[j] + Offset;
+			for (auto pl = 0; pl < 4; ++pl) {
+				Planes[pl] |= ((ColorIndex >> pl) & 1) << (Count - 1 - j);
+			}
+		}
+#endif
+		return Planes;
+	}
+	//!< p^[̑Ss x ڂ Count sNZ Gather 
+	template<uint32_t Count, size_t H, size_t W>
+	static std::array<std::array<uint16_t, 4>, H> Gather(const std::array<std::array<uint8_t, W>, H>& Pat, const uint32_t x, const uint32_t Offset) {
+		static_assert(W >= Count);
+		std::array<std::array<uint16_t, 4>, H> Rows;
+		for (auto i = 0; i < H; ++i) {
+			Rows[i] = Gather<Count>(&Pat[i][x], Offset);
+		}
+		return Rows;
+	}
+}
+
+//!< .bin, .txt ̏o
+//!< e̓֗߂ĂAClose() (܂̓fXgN^) łꂼ 1 ŏo
+class OutputBuffer
+{
+public:
+	OutputBuffer(std::string_view Name) : Name(Name) {
+		Text.reserve(4096);
+		Bin.reserve(1024);
+	}
+	//!< fXgN^͗O𓊂Ȃ̂ŁAo̎soɂ Close() ĂԂ
+	~OutputBuffer() {
+		try { Close(); }
+		catch (const std::exception& e) { Console::Err() << e.what() << std::endl; }
+	}
+
+	void Reserve(const size_t TextSize, const size_t BinSize) {
+		Text.reserve(TextSize);
+		Bin.reserve(BinSize);
+	}
+
+	//!< eLXg
+	OutputBuffer& operator<<(std::string_view rhs) { Text.append(rhs); return *this; }
+	template<typename T>
+	void Header(std::string_view Var) {
+		Text.append("const u").append(std::to_string(sizeof(T) << 3)).append(" ").append(Var).append("[] = {\n");
+	}
+	void Footer() { Text.append("};\n"); }
+	//!< "0x" + ^̃TCY 16 i (e[u 1 oCg 2 ֕ϊ)
+	template<typename T>
+	void Hex(const T Value) {
+		static_assert(std::is_integral_v<T>);
+		static constexpr auto Table = []() {
+			std::array<char, 512> Tbl = {};
+			constexpr char Digits[] = "0123456789abcdef";
+			for (auto i = 0; i < 256; ++i) {
+				Tbl[(i << 1) + 0] = Digits[i >> 4];
+				Tbl[(i << 1) + 1] = Digits[i & 0xf];
+			}
+			return Tbl;
+		}();
+		char Buf[2 + (sizeof(T) << 1)] = { '0', 'x' };
+		for (auto i = 0; i < sizeof(T); ++i) {
+			const auto Byte = (static_cast<uint64_t>(Value) >> ((sizeof(T) - 1 - i) << 3)) & 0xff;
+			Buf[2 + (i << 1) + 0] = Table[(Byte << 1) + 0];
+			Buf[2 + (i << 1) + 1] = Table[(Byte << 1) + 1];
+		}
+		Text.append(Buf, sizeof(Buf));
+	}
+
+	//!< oCi
+	template<typename T>
+	void Write(const T& Value) {
+		static_assert(std::is_trivially_copyable_v<T>);
+		const auto Ptr = reinterpret_cast<const char*>(&Value);
+		Bin.insert(end(Bin), Ptr, Ptr + sizeof(Value));
+	}
+	template<typename T>
+	void Write(const std::vector<T>& Values) {
+		const auto Ptr = reinterpret_cast<const char*>(data(Values));
+		Bin.insert(end(Bin), Ptr, Ptr + size(Values) * sizeof(T));
+	}
+
+	void Close() {
+		if (Closed) { return; }
+		Closed = true;
+
+		if (nullptr != Written) {
+			Written->emplace_back(Name + ".bin");
+			Written->emplace_back(Name + ".txt");
+		}
+
+		//!< oɎsO𓊂ăWus (}jtFXgɋL^Ȃ)
+		std::ofstream OutBin(data(Name + ".bin"), std::ios::binary | std::ios::out);
+		OutBin.write(data(Bin), size(Bin));
+		OutBin.close();
+		if (OutBin.fail()) { throw std::runtime_error("Failed to write " + Name + ".bin"); }
+
+		//!< eLXg[hŏo (sR[h͏]ʂɏ])
+		std::ofstream OutText(data(Name + ".txt"), std::ios::out);
+		OutText.write(data(Text), size(Text));
+		OutText.close();
+		if (OutText.fail()) { throw std::runtime_error("Failed to write " + Name + ".txt"); }
+	}
+
+	//!< ot@C̋L^ (rh}jtFXgpAXbh)
+	static inline thread_local std::vector<std::string>* Written = nullptr;
+
+private:
+	std::string Name;
+	std::string Text;
+	std::vector<char> Bin;
+	bool Closed = false;
+};
+
+//!< fR[hς݉摜̃LbV (摜̍sQƂ̂ŁA1 񂾂fR[h)
+//!< pXƍXVL[ƂAeʂ𒴂łÂgꂽ̂j
+class ImageCache
+{
+public:
+	static ImageCache& Instance() { static ImageCache Cache; return Cache; }
+
+	void SetCapacity(const size_t Bytes) {
+		std::lock_guard Lock(Mutex);
+		Capacity = Bytes;
+		Evict();
+	}
+
+	//!< 摜ǂݍށAԂ cv::Mat ̓LbVƋLĂ̂ŏȂ
+	cv::Mat Read(std::string_view File) {
+		std::error_code EC;
+		const auto Path = std::filesystem::absolute(File, EC).string();
+		const auto Time = std::filesystem::last_write_time(Path, EC);
+
+		std::shared_ptr<Entry> Ent;
+		auto Decode = false;
+		{
+			std::lock_guard Lock(Mutex);
+			const auto It = Entries.find(Path);
+			if (end(Entries) != It && It->second->Time == Time) {
+				Ent = It->second;
+				Order.splice(begin(Order), Order, Ent->OrderIt);
+			}
+			else {
+				if (end(Entries) != It) {
+					Erase(It);
+				}
+				Ent = std::make_shared<Entry>();
+				Ent->Time = Time;
+				Ent->Image = Ent->Promise.get_future().share();
+				Ent->OrderIt = Order.emplace(begin(Order), Path);
+				Entries.emplace(Path, Ent);
+				Decode = true;
+			}
+		}
+		//!< fR[h̓bN̊Oōs (摜ṽXbh͊҂)
+		if (Decode) {
+			Trace::Scope Span([&]() { return "imread " + std::filesystem::path(Path).filename().string(); }, "decode");
+			cv::Mat Image;
+			try {
+				Image = cv::imread(Path);
+			}
+			catch (...) {
+				//!< ҂ĂXbh֗O`AsGg͎cȂ (ɗvꂽɓǂݒ)
+				Ent->Promise.set_exception(std::current_exception());
+				std::lock_guard Lock(Mutex);
+				if (const auto It = Entries.find(Path); end(Entries) != It && Ent == It->second) {
+					Erase(It);
+				}
+				throw;
+			}
+			Ent->Promise.set_value(Image);
+
+			std::lock_guard Lock(Mutex);
+			Ent->Ready = true;
+			Ent->Size = Image.total() * Image.elemSize();
+			Used += Ent->Size;
+			Evict();
+		}
+		return Ent->Image.get();
+	}
+
+	//!< Read() œ摜vbgtH[J[֕ϊ ( nullptr)
+	std::shared_ptr<const std::vector<uint16_t>> FindPlane(const cv::Mat& Image, std::string_view Platform) {
+		std::lock_guard Lock(Mutex);
+		if (const auto Ent = Find(Image); nullptr != Ent) {
+			if (const auto It = Ent->Planes.find(std::string(Platform)); end(Ent->Planes) != It) {
+				return It->second;
+			}
+		}
+		return nullptr;
+	}
+	void StorePlane(const cv::Mat& Image, std::string_view Platform, const std::vector<uint16_t>& Plane) {
+		std::lock_guard Lock(Mutex);
+		if (const auto Ent = Find(Image); nullptr != Ent) {
+			if (Ent->Planes.try_emplace(std::string(Platform), std::make_shared<const std::vector<uint16_t>>(Plane)).second) {
+				const auto Size = size(Plane) * sizeof(Plane[0]);
+				Ent->Size += Size;
+				Used += Size;
+				Evict();
+			}
+		}
+	}
+
+	//!< Read() œ摜F́AKey  1 񂾂 Func ōȍ~͓ cv::Mat Ԃ
+	//!< (摜QƂGgf[^ĝŁAConvertedCache łL)
+	cv::Mat Reduce(const cv::Mat& Image, std::string_view Key, const std::function<cv::Mat()>& Func) {
+		std::shared_ptr<Reduction> Red;
+		auto Create = false;
+		{
+			std::lock_guard Lock(Mutex);
+			if (const auto Ent = Find(Image); nullptr != Ent) {
+				auto& Slot = Ent->Reductions[std::string(Key)];
+				if (nullptr == Slot) {
+					Slot = std::make_shared<Reduction>();
+					Slot->Image = Slot->Promise.get_future().share();
+					Create = true;
+				}
+				Red = Slot;
+			}
+		}
+		//!< LbVOĂ΋LłȂ̂ł̂܂܍
+		if (nullptr == Red) { return Func(); }
+		if (Create) {
+			cv::Mat Dst;
+			try {
+				Dst = Func();
+			}
+			catch (...) {
+				Red->Promise.set_exception(std::current_exception());
+				//!< ŝ͎cȂ (ɗvꂽɍ蒼)
+				std::lock_guard Lock(Mutex);
+				if (const auto Ent = Find(Image); nullptr != Ent) {
+					if (const auto It = Ent->Reductions.find(std::string(Key)); end(Ent->Reductions) != It && Red == It->second) {
+						Ent->Reductions.erase(It);
+					}
+				}
+				throw;
+			}
+			Red->Promise.set_value(Dst);
+
+			std::lock_guard Lock(Mutex);
+			if (const auto Ent = Find(Image); nullptr != Ent && Dst.data != Image.data) {
+				const auto Size = Dst.total() * Dst.elemSize();
+				Ent->Size += Size;
+				Used += Size;
+				Evict();
+			}
+		}
+		return Red->Image.get();
+	}
+
+private:
+	struct Reduction
+	{
+		std::promise<cv::Mat> Promise;
+		std::shared_future<cv::Mat> Image;
+	};
+	struct Entry
+	{
+		std::filesystem::file_time_type Time;
+		std::promise<cv::Mat> Promise;
+		std::shared_future<cv::Mat> Image;
+		std::unordered_map<std::string, std::shared_ptr<const std::vector<uint16_t>>> Planes;
+		std::unordered_map<std::string, std::shared_ptr<Reduction>> Reductions; //!< Reduce() ̌ (L[͌F̎w)
+		std::list<std::string>::iterator OrderIt;
+		size_t Size = 0;
+		bool Ready = false;
+	};
+	using EntryMap = std::unordered_map<std::string, std::shared_ptr<Entry>>;
+
+	//!< LbVێĂ摜 (f[^LĂ) ̃GgT
+	Entry* Find(const cv::Mat& Image) {
+		for (auto& i : Entries) {
+			if (i.second->Ready && i.second->Image.get().data == Image.data) {
+				return i.second.get();
+			}
+		}
+		return nullptr;
+	}
+	//!< j Order ̎̈ʒuԂ
+	std::list<std::string>::iterator Erase(EntryMap::iterator It) {
+		Used -= It->second->Size;
+		const auto Next = Order.erase(It->second->OrderIt);
+		Entries.erase(It);
+		return Next;
+	}
+	//!< eʂ𒴂ĂÂ̂j (fR[ĥ̂͏)
+	void Evict() {
+		for (auto It = end(Order); Used > Capacity && begin(Order) != It;) {
+			if (const auto Ent = Entries.find(*--It); Ent->second->Ready) {
+				It = Erase(Ent);
+			}
+		}
+	}
+
+	std::mutex Mutex;
+	EntryMap Entries;
+	std::list<std::string> Order; //!< 擪قǍŋߎgꂽ
+	size_t Capacity = size_t(1) << 30;
+	size_t Used = 0;
+};
+
+//!< ϊʂ̃LbV (摜𓯂Ro[^ŕϊGg Create()  1 񂾂s)
+//!< PALETTE, TILESET, MAP 摜QƂꍇA}bvApbgAp^[̍쐬LAo͂Ggɍs
+//!< ϊɑ̃Xbĥvꍇ͊҂
+//!< ϊʂ͉摜t@C (Source) ɎQƂGg𐔂ĂAŌ̃Gg̏Ij
+class ConvertedCache
+{
+public:
+	//!< Image (Source ǂݍ񂾂)  T  Create() ́ALĂ̂ const ̃\bh (Output n) ̂ݎg
+	template<typename T>
+	std::shared_ptr<const T> Get(const cv::Mat& Image, std::string_view Source) {
+		const Key K = { std::type_index(typeid(T)), Image.data, Image.cols, Image.rows };
+
+		std::shared_ptr<Entry> Ent;
+		auto Create = false;
+		{
+			std::lock_guard Lock(Mutex);
+			auto& Slot = Entries[K];
+			if (nullptr == Slot) {
+				Slot = std::make_shared<Entry>();
+				//!< Ro[^͉摜QƂŎ̂ŁAGg摜ێ (f[^̃AhXėp邱ƂȂ)
+				Slot->Image = Image;
+				Slot->Source = Normalize(Source);
+				Slot->Result = Slot->Promise.get_future().share();
+				Create = true;
+			}
+			Ent = Slot;
+		}
+		//!< ϊ̓bN̊Oōs
+		if (Create) {
+			Trace::Scope Span("Create");
+			try {
+				auto Conv = std::make_shared<T>(Ent->Image);
+				Conv->Create();
+				Ent->Promise.set_value(std::move(Conv));
+			}
+			catch (...) {
+				Ent->Promise.set_exception(std::current_exception());
+			}
+		}
+		//!< Ԃ̂gĂԂ̓Gg (摜) jȂ悤ɂ
+		return std::shared_ptr<const T>(Ent, static_cast<const T*>(Ent->Result.get().get()));
+	}
+	//!< Source QƂGg 1 ₷ (Read() ŃWu鎞ɐ)
+	void AddUser(std::string_view Source) {
+		std::lock_guard Lock(Mutex);
+		++Users[Normalize(Source)];
+	}
+	//!< Source QƂGg̏IAŌ̂̂Ȃ Source ̕ϊʂj
+	//!< (gp͕̂̂Ԃ std::shared_ptr ێĂ̂ŁAgI_ŉ)
+	void Release(std::string_view Source) {
+		std::lock_guard Lock(Mutex);
+		const auto It = Users.find(Normalize(Source));
+		if (end(Users) == It || 0 < --It->second) { return; }
+		std::erase_if(Entries, [&](const auto& rhs) { return rhs.second->Source == It->first; });
+		Users.erase(It);
+	}
+	void Clear() {
+		std::lock_guard Lock(Mutex);
+		Entries.clear();
+		Users.clear();
+	}
+
+private:
+	static std::string Normalize(std::string_view Source) { return std::filesystem::path(Source).lexically_normal().string(); }
+
+	using Key = std::tuple<std::type_index, const uchar*, int, int>;
+	struct Entry
+	{
+		cv::Mat Image;
+		std::string Source;
+		std::promise<std::shared_ptr<const void>> Promise;
+		std::shared_future<std::shared_ptr<const void>> Result;
+	};
+
+	std::mutex Mutex;
+	std::map<Key, std::shared_ptr<Entry>> Entries;
+	std::unordered_map<std::string, uint32_t> Users; //!< 摜t@ĆȀIĂȂGg̐
+};
+
+//!< rh}jtFXgAGg (.res ̍s) ɓ͂Əo͂L^ĕύX̖͕̂ϊXLbv
+class BuildManifest
+{
+public:
+	//!< o͓eςCグ邱
+	static constexpr uint32_t ConverterVersion = 3;
+	static constexpr std::string_view FileName = "ImageConverter.manifest";
+
+	//!< t@C̃TCYƍXV
+	struct FileStamp
+	{
+		std::string Path;
+		uintmax_t Size = 0;
+		int64_t Time = 0;
+		bool operator==(const FileStamp&) const = default;
+
+		static FileStamp Get(std::string_view Path) {
+			FileStamp Stamp({ .Path = std::string(Path) });
+			std::error_code EC;
+			if (std::filesystem::is_regular_file(Path, EC)) {
+				Stamp.Size = std::filesystem::file_size(Path, EC);
+				Stamp.Time = std::filesystem::last_write_time(Path, EC).time_since_epoch().count();
+			}
+			return Stamp;
+		}
+	};
+	struct Record
+	{
+		std::string Platform;
+		std::string Reduce; //!< 摜ɓKpF (REDUCE ̎wA΋)
+		uint32_t Version = ConverterVersion;
+		FileStamp Source;
+		uint64_t SourceHash = 0;
+		std::vector<FileStamp> Outputs;
+	};
+
+	//!< L[ .res t@CƂ̍s (}jtFXg̋؂̃^u܂܂Ȃ悤ɃGXP[v)
+	static std::string GetKey(std::string_view Res, std::string_view Line) { return Escape(Res) + "\t" + Escape(Line); }
+
+	//!< ^uAsA\ GXP[v
+	static std::string Escape(std::string_view Str) {
+		std::string Dst;
+		Dst.reserve(size(Str));
+		for (auto c : Str) {
+			switch (c) {
+			case '\\': Dst += "\\\\"; break;
+			case '\t': Dst += "\\t"; break;
+			case '\r': Dst += "\\r"; break;
+			case '\n': Dst += "\\n"; break;
+			default: Dst += c; break;
+			}
+		}
+		return Dst;
+	}
+	static std::string Unescape(std::string_view Str) {
+		std::string Dst;
+		Dst.reserve(size(Str));
+		for (size_t i = 0; i < size(Str); ++i) {
+			if ('\\' == Str[i] && i + 1 < size(Str)) {
+				switch (Str[++i]) {
+				case 't': Dst += '\t'; break;
+				case 'r': Dst += '\r'; break;
+				case 'n': Dst += '\n'; break;
+				default: Dst += Str[i]; break;
+				}
+			}
+			else {
+				Dst += Str[i];
+			}
+		}
+		return Dst;
+	}
+
+	void Load() {
+		Records.clear();
+		std::ifstream In(data(std::string(FileName)), std::ios::in);
+		if (In.fail()) { return; }
+		Record* Rec = nullptr;
+		std::string Line;
+		while (std::getline(In, Line)) {
+			std::vector<std::string> Items;
+			std::stringstream SS(Line);
+			std::string Item;
+			while (std::getline(SS, Item, '\t')) {
+				Items.emplace_back(Item);
+			}
+			//!< ꂽ (lƂēǂ߂Ȃ) L^͖̂Ƃ (̃Gg͕ϊ)
+			std::string Key;
+			try {
+				if (10 == size(Items) && "E" == Items[0]) {
+					//!< L[̓GXP[v܂
+					Key = Items[1] + "\t" + Items[2];
+					Record R({ .Platform = Items[3], .Reduce = Unescape(Items[4]), .Version = static_cast<uint32_t>(std::stoul(Items[5])) });
+					R.Source = FileStamp({ .Path = Unescape(Items[6]), .Size = std::stoull(Items[7]), .Time = std::stoll(Items[8]) });
+					R.SourceHash = std::stoull(Items[9], nullptr, 16);
+					Rec = &(Records[Key] = std::move(R));
+				}
+				else if (4 == size(Items) && "O" == Items[0] && nullptr != Rec) {
+					Rec->Outputs.emplace_back(FileStamp({ .Path = Unescape(Items[1]), .Size = std::stoull(Items[2]), .Time = std::stoll(Items[3]) }));
+				}
+			}
+			catch (const std::logic_error&) {
+				if (!empty(Key)) {
+					Records.erase(Key);
+				}
+				else if (nullptr != Rec) {
+					std::erase_if(Records, [&](const auto& rhs) { return &rhs.second == Rec; });
+				}
+				Rec = nullptr;
+			}
+		}
+	}
+	void Save() const {
+		std::string Text = "# ImageConverter manifest\n";
+		for (const auto& [Key, Rec] : Records) {
+			std::stringstream SS;
+			SS << "E\t" << Key << "\t" << Rec.Platform << "\t" << Escape(Rec.Reduce) << "\t" << Rec.Version << "\t" << Escape(Rec.Source.Path) << "\t" << Rec.Source.Size << "\t" << Rec.Source.Time << "\t" << std::hex << Rec.SourceHash << std::dec << "\n";
+			for (const auto& i : Rec.Outputs) {
+				SS << "O\t" << Escape(i.Path) << "\t" << i.Size << "\t" << i.Time << "\n";
+			}
+			Text += SS.str();
+		}
+		//!< orŒfĂȂ悤ɁAꎞt@Cu
+		const auto Temp = std::string(FileName) + ".tmp";
+		{
+			std::ofstream Out(Temp, std::ios::binary | std::ios::out);
+			Out.write(data(Text), size(Text));
+		}
+		std::error_code EC;
+		std::filesystem::rename(Temp, FileName, EC);
+	}
+
+	//!< ݂̓͂L^ (\[X̃TCYƍXVOƓȂnbVvZȂ)
+	Record CreateRecord(std::string_view Platform, std::string_view Source) const {
+		Record Rec({ .Platform = std::string(Platform), .Source = FileStamp::Get(Source) });
+		const auto It = std::ranges::find_if(Records, [&](const auto& rhs) { return rhs.second.Source == Rec.Source; });
+		Rec.SourceHash = end(Records) != It ? It->second.SourceHash : GetFileHash(Source);
+		return Rec;
+	}
+	//!< ͂OƓŁAȌo͂폜ĂȂ
+	bool IsUpToDate(const std::string& Key, const Record& Rec) const {
+		const auto It = Records.find(Key);
+		if (end(Records) == It) { return false; }
+		const auto& Prev = It->second;
+		if (Prev.Platform != Rec.Platform || Prev.Reduce != Rec.Reduce || Prev.Version != Rec.Version || Prev.SourceHash != Rec.SourceHash || empty(Prev.Outputs)) { return false; }
+		return std::ranges::all_of(Prev.Outputs, [](const FileStamp& rhs) {
+			std::error_code EC;
+			return std::filesystem::is_regular_file(rhs.Path, EC) && FileStamp::Get(rhs.Path) == rhs;
+		});
+	}
+
+	//!< t@CẽnbV (FNV-1a)
+	static uint64_t GetFileHash(std::string_view Path) {
+		uint64_t Hash = 0xcbf29ce484222325ull;
+		std::ifstream In(data(std::string(Path)), std::ios::binary | std::ios::in);
+		std::array<char, 1 << 16> Buf;
+		while (In.read(data(Buf), size(Buf)) || 0 < In.gcount()) {
+			for (auto i = 0; i < In.gcount(); ++i) {
+				Hash = (Hash ^ static_cast<uint8_t>(Buf[i])) * 0x100000001b3ull;
+			}
+		}
+		return Hash;
+	}
+
+	std::map<std::string, Record> Records;
+};
+
 template<uint8_t W, uint8_t H>
 class Converter
 {
@@ -88,40 +952,199 @@ public:
 	class MapEntity
 	{
 	public:
+		enum FLAGS : uint32_t {
+			FLIP_H = 1 << 0, //!< ]
+			FLIP_V = 1 << 1, //!< ]
+		};
 		uint32_t PatternIndex = 0;
 		uint32_t Flags = 0;
 	};
+	//!< }bv (sDŘAɎAGetMapSize() ̑傫ňxmۂ)
+	class MapGrid
+	{
+	public:
+		void Resize(const cv::Size& Size) {
+			Width = Size.width;
+			Height = Size.height;
+			Entities.assign(static_cast<size_t>(Size.area()), MapEntity());
+		}
+		void Clear() { Width = Height = 0; Entities.clear(); }
+
+		int GetWidth() const { return Width; }
+		int GetHeight() const { return Height; }
+
+		MapEntity& operator()(const int Row, const int Col) { return Entities[static_cast<size_t>(Row) * Width + Col]; }
+		const MapEntity& operator()(const int Row, const int Col) const { return Entities[static_cast<size_t>(Row) * Width + Col]; }
+		std::span<MapEntity> GetRow(const int Row) { return { data(Entities) + static_cast<size_t>(Row) * Width, static_cast<size_t>(Width) }; }
+		std::span<const MapEntity> GetRow(const int Row) const { return { data(Entities) + static_cast<size_t>(Row) * Width, static_cast<size_t>(Width) }; }
+
+		//!< Svf (sD)
+		std::vector<MapEntity>& GetEntities() { return Entities; }
+		const std::vector<MapEntity>& GetEntities() const { return Entities; }
 
-	using Palette = std::vector<uint32_t>;
+	private:
+		int Width = 0;
+		int Height = 0;
+		std::vector<MapEntity> Entities;
+	};
+
+	//!< vbgtH[J[ (9 rbgJ[ or J[e[ũCfbNX)  16 rbgɎ܂
+	using Palette = std::vector<uint16_t>;
 
-	//!< 32 rbgJ[p^[ or J[CfbNXp^[
-	using PatternEntity = std::array<std::array<uint32_t, W>, H>;
+	//!< vbgtH[J[̎ސ̏ (PCE  9 rbgJ[)
+	static constexpr uint32_t MaxPlatformColorCount = 1 << 9;
+	//!< vbgtH[J[̏W (aW ORAF popcount ŋ܂)
+	class ColorSet
+	{
+	public:
+		ColorSet() = default;
+		explicit ColorSet(const Palette& Pal) {
+			for (auto i : Pal) {
+				Set(i);
+			}
+		}
+		void Set(const uint16_t Color) { Words[Color >> 6] |= 1ull << (Color & 63); }
+
+		ColorSet& operator|=(const ColorSet& rhs) {
+			for (auto i = 0; i < size(Words); ++i) {
+				Words[i] |= rhs.Words[i];
+			}
+			return *this;
+		}
+		ColorSet operator|(const ColorSet& rhs) const { return ColorSet(*this) |= rhs; }
+
+		size_t Count() const {
+			size_t Cnt = 0;
+			for (auto i : Words) {
+				Cnt += std::popcount(i);
+			}
+			return Cnt;
+		}
+
+		//!< ɕׂpbg
+		Palette ToPalette() const {
+			Palette Pal;
+			Pal.reserve(Count());
+			for (auto i = 0; i < size(Words); ++i) {
+				for (auto w = Words[i]; w; w &= w - 1) {
+					Pal.emplace_back(static_cast<uint16_t>(i * 64 + std::countr_zero(w)));
+				}
+			}
+			return Pal;
+		}
+
+	private:
+		std::array<uint64_t, MaxPlatformColorCount / 64> Words = {};
+	};
+
+	//!< vbgtH[J[̃p^[
+	using PatternEntity = std::array<std::array<uint16_t, W>, H>;
+	//!< J[CfbNX̃p^[ (pbg̃CfbNX 8 rbgɎ܂)
+	using IndexPatternEntity = std::array<std::array<uint8_t, W>, H>;
 	//!< pbgCfbNX + J[CfbNXp^[
 	class Pattern
 	{
 	public:
 		bool HasValidPaletteIndex() const { return 0xffffffff != PaletteIndex; }
 		uint32_t PaletteIndex = 0xffffffff;
-		PatternEntity ColorIndices;
+		IndexPatternEntity ColorIndices;
 	};
 
+	//!< XVp̕ϊ
+	struct Snapshot
+	{
+		cv::Size MapSize;
+		std::vector<size_t> TileHashes;
+		std::vector<MapEntity> Map;
+		std::vector<PatternEntity> ColorPatterns;
+		std::vector<Palette> SourcePalettes;
+		std::vector<Palette> Palettes;
+		std::vector<Pattern> Patterns;
+	};
+
+	//!< p^[̃nbV (FNV-1a ōsɏݍ)
+	static size_t GetPatternHash(const PatternEntity& Pat) {
+		uint64_t Hash = 0xcbf29ce484222325ull;
+		for (const auto& i : Pat) {
+			for (auto j : i) {
+				Hash = (Hash ^ j) * 0x100000001b3ull;
+			}
+		}
+		return static_cast<size_t>(Hash);
+	}
+	//!< ] (MapEntity::FLAGS) ̃p^[̃nbVA[0]  GetPatternHash() ƓlɂȂ
+	static std::array<size_t, 4> GetFlippedPatternHashes(const PatternEntity& Pat) {
+		std::array<uint64_t, 4> Hash;
+		Hash.fill(0xcbf29ce484222325ull);
+		for (auto i = 0; i < H; ++i) {
+			for (auto j = 0; j < W; ++j) {
+				Hash[0] = (Hash[0] ^ Pat[i][j]) * 0x100000001b3ull;
+				Hash[MapEntity::FLIP_H] = (Hash[MapEntity::FLIP_H] ^ Pat[i][W - 1 - j]) * 0x100000001b3ull;
+				Hash[MapEntity::FLIP_V] = (Hash[MapEntity::FLIP_V] ^ Pat[H - 1 - i][j]) * 0x100000001b3ull;
+				Hash[MapEntity::FLIP_H | MapEntity::FLIP_V] = (Hash[MapEntity::FLIP_H | MapEntity::FLIP_V] ^ Pat[H - 1 - i][W - 1 - j]) * 0x100000001b3ull;
+			}
+		}
+		return { static_cast<size_t>(Hash[0]), static_cast<size_t>(Hash[1]), static_cast<size_t>(Hash[2]), static_cast<size_t>(Hash[3]) };
+	}
+	//!< ]lvf̎擾
+	template<typename T>
+	static T GetFlipped(const std::array<std::array<T, W>, H>& Pat, const uint32_t Flags, const int i, const int j) {
+		return Pat[(Flags & MapEntity::FLIP_V) ? H - 1 - i : i][(Flags & MapEntity::FLIP_H) ? W - 1 - j : j];
+	}
+	//!< lhs  Flags Ŕ]̂ rhs ƈv邩
+	static bool IsFlippedEqual(const PatternEntity& lhs, const PatternEntity& rhs, const uint32_t Flags) {
+		if (0 == Flags) { return lhs == rhs; }
+		for (auto i = 0; i < H; ++i) {
+			for (auto j = 0; j < W; ++j) {
+				if (GetFlipped(lhs, Flags, i, j) != rhs[i][j]) { return false; }
+			}
+		}
+		return true;
+	}
+
 	virtual uint16_t ToPlatformColor(const cv::Vec3b& Color) const { return 0; }
 	virtual cv::Vec3b FromPlatformColor(const uint16_t& Color) const { return cv::Vec3b(0, 0, 0); }
+	//!< vbgtH[J[̎ސ (ToPlatformColor()  [0, GetPlatformColorCount()) ̒lԂ)
+	virtual uint32_t GetPlatformColorCount() const { return MaxPlatformColorCount; }
+
+	//!< vbgtH[J[pbg̃CfbNXe[u (pbgɖF NoIndex)
+	using ColorIndexTable = std::vector<uint8_t>;
+	static constexpr uint8_t NoIndex = 0xff;
+	ColorIndexTable CreateColorIndexTable(const Palette& Pal) const {
+		ColorIndexTable Table(GetPlatformColorCount(), NoIndex);
+		//!< Fΐ擪̂̂
+		for (auto i = static_cast<int>(size(Pal)) - 1; i >= 0; --i) {
+			Table[Pal[i]] = static_cast<uint8_t>(i);
+		}
+		return Table;
+	}
 
-	virtual PatternEntity& ToPlatformColorPattern(PatternEntity& lhs, const cv::Mat& rhs) const {
-		for (auto i = 0; i < rhs.rows; ++i) {
-			for (auto j = 0; j < rhs.cols; ++j) {
-				lhs[i][j] = ToPlatformColor(rhs.ptr<cv::Vec3b>(i)[j]);
+	//!< vbgtH[ (ϊς݃J[̃LbṼL[AȂLbVȂ)
+	virtual std::string_view GetPlatformName() const { return ""; }
+
+	//!< 摜ŜxɃvbgtH[J[֕ϊ (Img.cols x Img.rows ̍sD)
+	virtual void ToPlatformColorPlane(std::vector<uint16_t>& Plane, const cv::Mat& Img) const {
+		Plane.resize(Img.total());
+		for (auto i = 0; i < Img.rows; ++i) {
+			const auto Src = Img.ptr<cv::Vec3b>(i);
+			const auto Dst = &Plane[i * Img.cols];
+			for (auto j = 0; j < Img.cols; ++j) {
+				Dst[j] = ToPlatformColor(Src[j]);
 			}
 		}
+	}
+	//!< ϊς݂̉摜S (ColorPlane) p^[؂o
+	PatternEntity& ToPlatformColorPattern(PatternEntity& lhs, const int x, const int y) const {
+		for (auto i = 0; i < H; ++i) {
+			std::copy_n(&ColorPlane[(y + i) * Image.cols + x], W, begin(lhs[i]));
+		}
 		return lhs;
 	}
+	//!< PaletteIndexTables (CreatePattern() Ńpbg܂Ƃ߂ɍ) ăCfbNXJ[ɂ
 	virtual Pattern& ToIndexColorPattern(Pattern& Pat, const uint32_t PalIdx, const PatternEntity& ColPat) {
-		const auto& Pal = Palettes[(Pat.PaletteIndex = PalIdx)];
+		const auto& Table = PaletteIndexTables[(Pat.PaletteIndex = PalIdx)];
 		for (auto i = 0; i < size(ColPat); ++i) {
-			for (auto j = 0; j < size(ColPat[i]); ++j) {
-				Pat.ColorIndices[i][j] = static_cast<uint32_t>(std::distance(begin(Pal), std::ranges::find(Pal, ColPat[i][j])));
-			}
+			std::ranges::transform(ColPat[i], begin(Pat.ColorIndices[i]), [&](const uint16_t rhs) { return Table[rhs]; });
 		}
 		return Pat;
 	}
@@ -134,6 +1157,9 @@ public:
 	virtual uint16_t GetPaletteReservedColorCount() const { return HasPaletteReservedColor() ? 1 : 0; }
 	virtual uint16_t GetPaletteReservedColor() const { return 0x0000; }
 
+	//!< n[hEFAp^[̔]\T|[g邩 (]Ĉvp^[܂Ƃ߂)
+	virtual bool IsFlipSupported() const { return false; }
+
 	virtual cv::Size GetMapSize(const uint8_t w, const uint8_t h) const { return cv::Size(Image.cols / w, Image.rows / h); }
 	virtual cv::Size GetMapSize() const { return GetMapSize(W, H); }
 
@@ -144,100 +1170,457 @@ public:
 		CreatePattern();
 		return *this;
 	}
+	//!< O̕ϊ (Name ̃XibvVbg) ΁Aω^Cϊ
+	//!< p^[ԍpbgςĂ܂ꍇ͑Ŝϊ
+	Converter& CreateIncremental(std::string_view Name) { return CreateIncremental(Name, nullptr); }
+	//!< ŜϊꍇAFull Εϊɂ̌ (摜 Create() ) Rs[
+	Converter& CreateIncremental(std::string_view Name, const std::function<std::shared_ptr<const Converter>()>& Full) {
+		Snapshot Prev;
+		if (LoadSnapshot(Name, Prev) && UpdateMap(Prev)) {
+			CreatePalette();
+			if (Palettes == Prev.SourcePalettes) {
+				//!< p^[Apbg͂̂܂܎g
+				SourcePalettes = std::move(Prev.SourcePalettes);
+				Palettes = std::move(Prev.Palettes);
+				Patterns = std::move(Prev.Patterns);
+			}
+			else {
+				CreatePattern();
+			}
+		}
+		else if (Full) {
+			CopyResult(*Full());
+		}
+		else {
+			Map.Clear();
+			ColorPatterns.clear();
+			ColorPatternIndices.clear();
+			TileHashes.clear();
+			Create();
+		}
+		SaveSnapshot(Name);
+		return *this;
+	}
 
-	virtual Converter& CreateMap() {
+	//!< ϊʂRs[ (摜͓̂ł邱)
+	void CopyResult(const Converter& rhs) {
+		ColorPlane = rhs.ColorPlane;
+		ColorPatterns = rhs.ColorPatterns;
+		ColorPatternIndices = rhs.ColorPatternIndices;
+		TileHashes = rhs.TileHashes;
+		Map = rhs.Map;
+		SourcePalettes = rhs.SourcePalettes;
+		Palettes = rhs.Palettes;
+		PaletteIndexTables = rhs.PaletteIndexTables;
+		Patterns = rhs.Patterns;
+	}
+
+	//!< s̑ђPʂŏd (PatternIndex ͑ѓ̃CfbNX)
+	struct Band
+	{
+		std::vector<PatternEntity> Patterns;
+		std::vector<size_t> Hashes;
+		int Begin = 0; //!< т̐擪s
+		std::vector<MapEntity> Map; //!< т̍s (sD)
+	};
+	//!< т̐ (ȃ}bv͕Ȃ)
+	static uint32_t GetBandCount(const cv::Size& MapSize) {
+		if (MapSize.area() < 64 * 64) { return 1; }
+		return std::clamp(Parallel::GetThreadCount(), 1u, static_cast<uint32_t>(MapSize.height));
+	}
+	//!< }bv [Begin, End) sт̒ŏd
+	//!< ]̗L̓^Cɖ₢킹ɃRpCɌ߂Ă (CreateMap() ŐU蕪)
+	template<bool Flip>
+	void CreateBand(Band& Bnd, const int Begin, const int End) const {
+		//!< ]ĊɂȂ̂͒ǉȂ (] Flags Ɏ)
+		//!< ]T|[gꍇ 4 ʂ̔]̃nbV̍ŏl\lƂ
+		constexpr auto FlipCount = Flip ? 4u : 1u;
+		std::unordered_multimap<size_t, uint32_t> Indices;
 		const auto MapSize = GetMapSize();
-		for (auto i = 0; i < MapSize.height; ++i) {
-			auto& MapEnt = Map.emplace_back();
+		Bnd.Begin = Begin;
+		Bnd.Map.reserve(static_cast<size_t>(End - Begin) * MapSize.width);
+		for (auto i = Begin; i < End; ++i) {
 			for (auto j = 0; j < MapSize.width; ++j) {
-				const cv::Mat cvPat = Image(cv::Rect(j * W, i * H, W, H));
-#if 0
-				//!< ]ĊɂȂ̂͒ǉȂ #TODO
-				cv::Mat cvPatV, cvPatH, cvPatVH;
-				cv::flip(cvPat, cvPatV, 0);
-				cv::flip(cvPat, cvPatH, 1);
-				cv::flip(cvPat, cvPatVH, -1);
-
-				PatternEntity Pat, PatV, PatH, PatVH;
-				ToPlatformColorPattern(Pat, cvPat);
-				ToPlatformColorPattern(PatV, cvPatV);
-				ToPlatformColorPattern(PatH, cvPatH);
-				ToPlatformColorPattern(PatVH, cvPatVH);
-				const auto It = std::ranges::find_if(ColorPatterns, [&](const PatternEntity& rhs) { return rhs == Pat || rhs == PatV || rhs == PatH || rhs == PatVH; });
-#else
 				PatternEntity Pat;
-				ToPlatformColorPattern(Pat, cvPat);
-				const auto It = std::ranges::find_if(ColorPatterns, [&](const PatternEntity& rhs) { return rhs == Pat; });
-#endif
-				if (end(ColorPatterns) != It) {
-					MapEnt.emplace_back(MapEntity({ .PatternIndex = static_cast<uint32_t>(std::distance(begin(ColorPatterns), It)), .Flags = 0 }));
+				ToPlatformColorPattern(Pat, j * W, i * H);
+
+				size_t Hash;
+				if constexpr (Flip) {
+					Hash = std::ranges::min(GetFlippedPatternHashes(Pat));
 				}
 				else {
-					MapEnt.emplace_back(MapEntity({ .PatternIndex = static_cast<uint32_t>(size(ColorPatterns)), .Flags = 0 }));
-					ColorPatterns.emplace_back(Pat);
+					Hash = GetPatternHash(Pat);
 				}
+
+				//!< nbVv̂Sr
+				const auto [B, E] = Indices.equal_range(Hash);
+				auto Found = false;
+				for (auto It = B; It != E && !Found; ++It) {
+					for (auto f = 0u; f < FlipCount; ++f) {
+						if (IsFlippedEqual(Bnd.Patterns[It->second], Pat, f)) {
+							Bnd.Map.emplace_back(MapEntity({ .PatternIndex = It->second, .Flags = f }));
+							Found = true;
+							break;
+						}
+					}
+				}
+				if (!Found) {
+					Bnd.Map.emplace_back(MapEntity({ .PatternIndex = static_cast<uint32_t>(size(Bnd.Patterns)), .Flags = 0 }));
+					Indices.emplace(Hash, static_cast<uint32_t>(size(Bnd.Patterns)));
+					Bnd.Patterns.emplace_back(Pat);
+					Bnd.Hashes.emplace_back(Hash);
+				}
+			}
+		}
+	}
+	//!< тォ珇ɑŜ̃p^[փ}[W (p^[ԍA]͒ƓɂȂ)
+	void MergeBand(const Band& Bnd) {
+		const auto FlipCount = IsFlipSupported() ? 4u : 1u;
+		//!< ѓ (p^[, ]) Ŝ (p^[, ]) ւ̕ϊ
+		std::vector<std::array<MapEntity, 4>> Remap(size(Bnd.Patterns));
+		for (auto k = 0; k < size(Bnd.Patterns); ++k) {
+			const auto& Pat = Bnd.Patterns[k];
+			const auto [B, E] = ColorPatternIndices.equal_range(Bnd.Hashes[k]);
+			auto Found = false;
+			for (auto It = B; It != E && !Found; ++It) {
+				//!< v锽]S (Ώ̂ȃp^[͕)
+				std::array<bool, 4> Matches = {};
+				for (auto f = 0u; f < FlipCount; ++f) {
+					Found = (Matches[f] = IsFlippedEqual(ColorPatterns[It->second], Pat, f)) || Found;
+				}
+				if (Found) {
+					//!< ѓ f ]Ă^C͑Ŝ̃p^[ (m ^ f) ]̂ɂȂAƓŏ̔]I
+					for (auto f = 0u; f < FlipCount; ++f) {
+						auto Flags = 0xffffffffu;
+						for (auto m = 0u; m < FlipCount; ++m) {
+							if (Matches[m]) { Flags = (std::min)(Flags, m ^ f); }
+						}
+						Remap[k][f] = MapEntity({ .PatternIndex = It->second, .Flags = Flags });
+					}
+				}
+			}
+			if (!Found) {
+				const auto Index = static_cast<uint32_t>(size(ColorPatterns));
+				ColorPatternIndices.emplace(Bnd.Hashes[k], Index);
+				ColorPatterns.emplace_back(Pat);
+				for (auto f = 0u; f < FlipCount; ++f) {
+					Remap[k][f] = MapEntity({ .PatternIndex = Index, .Flags = f });
+				}
+			}
+		}
+		std::ranges::transform(Bnd.Map, begin(Map.GetEntities()) + static_cast<size_t>(Bnd.Begin) * Map.GetWidth(), [&](const MapEntity& rhs) { return Remap[rhs.PatternIndex][rhs.Flags]; });
+	}
+
+	//!< 摜ŜvbgtH[J[֕ϊ (ϊς݂ȂLbVg)
+	void CreateColorPlane() {
+		const auto Platform = GetPlatformName();
+		if (const auto Cached = empty(Platform) ? nullptr : ImageCache::Instance().FindPlane(Image, Platform); nullptr != Cached) {
+			ColorPlane = *Cached;
+			return;
+		}
+		ToPlatformColorPlane(ColorPlane, Image);
+		if (!empty(Platform)) {
+			ImageCache::Instance().StorePlane(Image, Platform, ColorPlane);
+		}
+	}
+	//!< ColorCount FȉɌF摜 (F܂Ă΂̂܂ܕԂ)
+	//!< vbgtH[J[̃qXgOŏdݕt k-means sANX^̒SvbgtH[J[֊ۂ߂
+	//!< ͉̂摜̈قȂvbgtH[J[ (XSF) Ȃ̂ŁAsNZŜ k-means s CV::ColorReduction() 茅Ⴂɑ
+	cv::Mat ReduceColor(const uint32_t ColorCount) {
+		Trace::Scope Span("ReduceColor");
+		CreateColorPlane();
+
+		//!< vbgtH[J[̃sNZ (іɕɐčZ)
+		const auto ColorRange = GetPlatformColorCount();
+		const auto BandCount = size(ColorPlane) < (1 << 16) ? 1u : std::clamp(Parallel::GetThreadCount(), 1u, 16u);
+		std::vector<std::vector<uint32_t>> Histograms(BandCount, std::vector<uint32_t>(ColorRange, 0));
+		const auto Count = [&](const uint32_t b) {
+			const auto Begin = size(ColorPlane) * b / BandCount;
+			const auto End = size(ColorPlane) * (b + 1) / BandCount;
+			auto& Hist = Histograms[b];
+			for (auto i = Begin; i < End; ++i) {
+				++Hist[ColorPlane[i]];
+			}
+		};
+		{
+			std::vector<std::thread> Threads;
+			for (auto b = 1u; b < BandCount; ++b) {
+				Threads.emplace_back(Count, b);
+			}
+			Count(0);
+			for (auto& i : Threads) {
+				i.join();
+			}
+		}
+
+		//!< gĂF (RGB Ԃ̓_ƂĈ)
+		using Point = std::array<float, 3>;
+		const auto ToPoint = [](const cv::Vec3b& rhs) { return Point({ static_cast<float>(rhs[0]), static_cast<float>(rhs[1]), static_cast<float>(rhs[2]) }); };
+		const auto DistSq = [](const Point& lhs, const Point& rhs) { return (lhs[0] - rhs[0]) * (lhs[0] - rhs[0]) + (lhs[1] - rhs[1]) * (lhs[1] - rhs[1]) + (lhs[2] - rhs[2]) * (lhs[2] - rhs[2]); };
+		std::vector<uint16_t> Colors;
+		std::vector<float> Weights;
+		std::vector<Point> Points;
+		for (uint32_t i = 0; i < ColorRange; ++i) {
+			uint32_t Weight = 0;
+			for (const auto& j : Histograms) {
+				Weight += j[i];
+			}
+			if (Weight) {
+				Colors.emplace_back(static_cast<uint16_t>(i));
+				Weights.emplace_back(static_cast<float>(Weight));
+				Points.emplace_back(ToPoint(FromPlatformColor(static_cast<uint16_t>(i))));
+			}
+		}
+		if (size(Colors) <= ColorCount) { return Image; }
+
+		//!< l͈ԑFn߂āA(d x ̒S܂ł̋) ő̐FɑI (gȂ̂Ōʂ͖񓯂)
+		std::vector<Point> Centers = { Points[std::distance(begin(Weights), std::ranges::max_element(Weights))] };
+		std::vector<float> MinDistSq(size(Points), (std::numeric_limits<float>::max)());
+		while (size(Centers) < ColorCount) {
+			for (auto i = 0; i < size(Points); ++i) {
+				MinDistSq[i] = (std::min)(MinDistSq[i], DistSq(Points[i], Centers.back()));
+			}
+			auto Best = 0;
+			for (auto i = 1; i < size(Points); ++i) {
+				if (Weights[i] * MinDistSq[i] > Weights[Best] * MinDistSq[Best]) { Best = i; }
+			}
+			if (0.0f == MinDistSq[Best]) { break; }
+			Centers.emplace_back(Points[Best]);
+		}
+
+		const auto Nearest = [&](const Point& rhs) {
+			uint32_t Index = 0;
+			for (uint32_t i = 1; i < size(Centers); ++i) {
+				if (DistSq(rhs, Centers[i]) < DistSq(rhs, Centers[Index])) { Index = i; }
+			}
+			return Index;
+		};
+		std::vector<uint32_t> Labels(size(Points), 0xffffffff);
+		for (auto It = 0; It < 16; ++It) {
+			auto Changed = false;
+			for (auto i = 0; i < size(Points); ++i) {
+				const auto Label = Nearest(Points[i]);
+				Changed = Label != Labels[i] || Changed;
+				Labels[i] = Label;
+			}
+			if (!Changed) { break; }
+
+			std::vector<Point> Sums(size(Centers), Point({ 0.0f, 0.0f, 0.0f }));
+			std::vector<float> Totals(size(Centers), 0.0f);
+			for (auto i = 0; i < size(Points); ++i) {
+				for (auto k = 0; k < 3; ++k) {
+					Sums[Labels[i]][k] += Points[i][k] * Weights[i];
+				}
+				Totals[Labels[i]] += Weights[i];
+			}
+			for (auto i = 0; i < size(Centers); ++i) {
+				if (0.0f < Totals[i]) {
+					for (auto k = 0; k < 3; ++k) {
+						Centers[i][k] = Sums[i][k] / Totals[i];
+					}
+				}
+			}
+		}
+
+		//!< SvbgtH[J[֊ۂ߂āAeFԋ߂S̐F֒u
+		std::vector<uint16_t> Reduced;
+		for (auto& i : Centers) {
+			Reduced.emplace_back(ToPlatformColor(cv::Vec3b(cv::saturate_cast<uchar>(i[0]), cv::saturate_cast<uchar>(i[1]), cv::saturate_cast<uchar>(i[2]))));
+			i = ToPoint(FromPlatformColor(Reduced.back()));
+		}
+		std::vector<cv::Vec3b> Table(ColorRange);
+		for (auto i = 0; i < size(Colors); ++i) {
+			Table[Colors[i]] = FromPlatformColor(Reduced[Nearest(Points[i])]);
+		}
+		cv::Mat Dst(Image.size(), Image.type());
+		for (auto i = 0; i < Image.rows; ++i) {
+			std::ranges::transform(&ColorPlane[static_cast<size_t>(i) * Image.cols], &ColorPlane[static_cast<size_t>(i) * Image.cols] + Image.cols, Dst.ptr<cv::Vec3b>(i), [&](const uint16_t rhs) { return Table[rhs]; });
+		}
+
+		std::ranges::sort(Reduced);
+		Console::Out() << "\tReduced color count = " << size(Colors) << " -> " << std::distance(begin(Reduced), std::ranges::unique(Reduced).begin()) << std::endl;
+		return Dst;
+	}
+	//!< ǑʂAnbV̕ς^C̃p^[Tă}bv
+	//!< Vp^[KvȏꍇAp^[̏o (= p^[ԍ) ςꍇ false
+	bool UpdateMap(const Snapshot& Prev) {
+		Trace::Scope Span("UpdateMap");
+		const auto MapSize = GetMapSize();
+		if (Prev.MapSize != MapSize || size(Prev.TileHashes) != static_cast<size_t>(MapSize.area())) { return false; }
+
+		CreateColorPlane();
+
+		const auto Flip = IsFlipSupported();
+		const auto FlipCount = Flip ? 4u : 1u;
+		ColorPatterns = Prev.ColorPatterns;
+		ColorPatternIndices.clear();
+		for (uint32_t i = 0; i < size(ColorPatterns); ++i) {
+			ColorPatternIndices.emplace(Flip ? std::ranges::min(GetFlippedPatternHashes(ColorPatterns[i])) : GetPatternHash(ColorPatterns[i]), i);
+		}
+
+		std::vector<bool> Used(size(ColorPatterns), false);
+		uint32_t NextFirst = 0;
+		uint32_t ChangedCount = 0;
+		TileHashes.resize(MapSize.area());
+		Map.Resize(MapSize);
+		for (auto i = 0; i < MapSize.height; ++i) {
+			for (auto j = 0; j < MapSize.width; ++j) {
+				const auto k = i * MapSize.width + j;
+				PatternEntity Pat;
+				ToPlatformColorPattern(Pat, j * W, i * H);
+				TileHashes[k] = GetPatternHash(Pat);
+
+				auto Ent = Prev.Map[k];
+				if (TileHashes[k] != Prev.TileHashes[k] || !IsFlippedEqual(ColorPatterns[Ent.PatternIndex], Pat, Ent.Flags)) {
+					++ChangedCount;
+					//!< ̃p^[T (CreateMap() ƓŒT̂Ŕ]̂ɂȂ)
+					const auto Hash = Flip ? std::ranges::min(GetFlippedPatternHashes(Pat)) : GetPatternHash(Pat);
+					const auto [B, E] = ColorPatternIndices.equal_range(Hash);
+					auto Found = false;
+					for (auto It = B; It != E && !Found; ++It) {
+						for (auto f = 0u; f < FlipCount && !Found; ++f) {
+							if (IsFlippedEqual(ColorPatterns[It->second], Pat, f)) {
+								Ent = MapEntity({ .PatternIndex = It->second, .Flags = f });
+								Found = true;
+							}
+						}
+					}
+					if (!Found) { return false; }
+				}
+				//!< p^[͏õ^Ĉ (]) ŁAoɔԍtĂȂ΂ȂȂ
+				if (!Used[Ent.PatternIndex]) {
+					if (NextFirst++ != Ent.PatternIndex || 0 != Ent.Flags) { return false; }
+					Used[Ent.PatternIndex] = true;
+				}
+				Map(i, j) = Ent;
+			}
+		}
+		//!< gȂȂp^[
+		if (NextFirst != size(ColorPatterns)) { return false; }
+
+		Console::Out() << "\tChanged tiles = " << ChangedCount << " / " << MapSize.area() << std::endl;
+		return true;
+	}
+
+	virtual Converter& CreateMap() {
+		Trace::Scope Span("CreateMap");
+		const auto MapSize = GetMapSize();
+		const auto BandCount = GetBandCount(MapSize);
+		const auto Flip = IsFlipSupported();
+
+		//!< 摜𓯂vbgtH[ŕϊς݂Ȃ炻g
+		const auto Platform = GetPlatformName();
+		const auto Cached = empty(Platform) ? nullptr : ImageCache::Instance().FindPlane(Image, Platform);
+		if (nullptr != Cached) {
+			ColorPlane = *Cached;
+		}
+		else {
+			ColorPlane.resize(Image.total());
+		}
+
+		//!< s̑іɁAvbgtH[J[ւ̕ϊƑѓł̏dɍs
+		std::vector<Band> Bands(BandCount);
+		const auto Process = [&](const uint32_t b) {
+			Trace::Scope Span([&]() { return "CreateBand " + std::to_string(b); });
+			const auto Begin = static_cast<int>(MapSize.height * b / BandCount);
+			const auto End = static_cast<int>(MapSize.height * (b + 1) / BandCount);
+			//!< Ō̑т̓}bvɊ܂܂Ȃ[̍sϊĂ
+			const auto Top = Begin * H;
+			const auto Bottom = BandCount - 1 == b ? Image.rows : End * H;
+			if (nullptr == Cached && Top < Bottom) {
+				std::vector<uint16_t> Plane;
+				ToPlatformColorPlane(Plane, Image(cv::Rect(0, Top, Image.cols, Bottom - Top)));
+				std::ranges::copy(Plane, begin(ColorPlane) + static_cast<size_t>(Top) * Image.cols);
 			}
+			if (Flip) {
+				CreateBand<true>(Bands[b], Begin, End);
+			}
+			else {
+				CreateBand<false>(Bands[b], Begin, End);
+			}
+		};
+		if (1 == BandCount) {
+			Process(0);
+		}
+		else {
+			std::vector<std::thread> Threads;
+			for (auto b = 1u; b < BandCount; ++b) {
+				Threads.emplace_back([&, b]() { Trace::SetThreadName([&]() { return "band " + std::to_string(b); }); Process(b); });
+			}
+			Process(0);
+			for (auto& i : Threads) {
+				i.join();
+			}
+		}
+
+		if (nullptr == Cached && !empty(Platform)) {
+			ImageCache::Instance().StorePlane(Image, Platform, ColorPlane);
+		}
+
+		Trace::Scope MergeSpan("MergeBand");
+		Map.Resize(MapSize);
+		for (const auto& i : Bands) {
+			MergeBand(i);
 		}
 		return *this;
 	}
 
-	void AddPatternColorToPalette(Palette& Pal, const PatternEntity& Pat)
+	void AddPatternColorToPalette(ColorSet& Set, const PatternEntity& Pat)
 	{
-		for (auto i : Pat) {
+		for (const auto& i : Pat) {
 			for (auto j : i) {
-				if (end(Pal) == std::ranges::find(Pal, j)) {
-					Pal.emplace_back(j);
-				}
+				Set.Set(j);
 			}
 		}
 	}
 	//!< p^[ 1 pbgƂP[X
 	void CreatePalettePerPattern() {
 		Palettes.clear();
+		Palettes.reserve(size(ColorPatterns));
 		for (const auto& p : ColorPatterns) {
-			auto& Pal = Palettes.emplace_back();
-			AddPatternColorToPalette(Pal, p);
+			ColorSet Set;
+			AddPatternColorToPalette(Set, p);
 
-			std::ranges::sort(Pal);
+			Palettes.emplace_back(Set.ToPalette());
 		}
 	}
 	//!< }bv̗񖈂 1 pbgƂP[X
 	void CreatePalettePerMapRow() {
 		Palettes.clear();
-		for (const auto& r : Map) {
-			auto& Pal = Palettes.emplace_back();
+		for (auto i = 0; i < Map.GetHeight(); ++i) {
+			ColorSet Set;
 
 			//!< ͓pbggȂ΂ȂȂ
-			for (const auto& c : r) {
-				AddPatternColorToPalette(Pal, ColorPatterns[c.PatternIndex]);
+			for (const auto& c : Map.GetRow(i)) {
+				AddPatternColorToPalette(Set, ColorPatterns[c.PatternIndex]);
 			}
 
-			std::ranges::sort(Pal);
+			Palettes.emplace_back(Set.ToPalette());
 		}
 	}
 	//!< }bv 2 x 2  1 pbgƂP[X
 	void CreatePalettePerMap2x2() {
 		Palettes.clear();
-		for (auto i = 0; i < size(Map); i += 2) {
-			for (auto j = 0; j < size(Map[i]); j += 2) {
-				auto& Pal = Palettes.emplace_back();
+		for (auto i = 0; i < Map.GetHeight(); i += 2) {
+			for (auto j = 0; j < Map.GetWidth(); j += 2) {
+				ColorSet Set;
 
 				//!< 2 x 2 ͓pbggȂ΂ȂȂ
-				AddPatternColorToPalette(Pal, ColorPatterns[Map[i + 0][j + 0].PatternIndex]);
-				AddPatternColorToPalette(Pal, ColorPatterns[Map[i + 0][j + 1].PatternIndex]);
-				AddPatternColorToPalette(Pal, ColorPatterns[Map[i + 1][j + 0].PatternIndex]);
-				AddPatternColorToPalette(Pal, ColorPatterns[Map[i + 1][j + 1].PatternIndex]);
+				AddPatternColorToPalette(Set, ColorPatterns[Map(i + 0, j + 0).PatternIndex]);
+				AddPatternColorToPalette(Set, ColorPatterns[Map(i + 0, j + 1).PatternIndex]);
+				AddPatternColorToPalette(Set, ColorPatterns[Map(i + 1, j + 0).PatternIndex]);
+				AddPatternColorToPalette(Set, ColorPatterns[Map(i + 1, j + 1).PatternIndex]);
 
-				std::ranges::sort(Pal);
+				Palettes.emplace_back(Set.ToPalette());
 			}
 		}
 	}
 #if 1
-	virtual Converter& CreatePalette() { CreatePalettePerPattern(); return *this; }
+	virtual Converter& CreatePalette() { Trace::Scope Span("CreatePalette"); CreatePalettePerPattern(); return *this; }
 #elif 0
-	virtual Converter& CreatePalette() { CreatePalettePerMapRow(); return *this; }
+	virtual Converter& CreatePalette() { Trace::Scope Span("CreatePalette"); CreatePalettePerMapRow(); return *this; }
 #else
-	virtual Converter& CreatePalette() { CreatePalettePerMap2x2(); return *this; }
+	virtual Converter& CreatePalette() { Trace::Scope Span("CreatePalette"); CreatePalettePerMap2x2(); return *this; }
 #endif
 
 	void CreatePattern(const std::vector<uint32_t>& PalInds) {
@@ -249,9 +1632,9 @@ public:
 	void CreatePatternPerMapRow(const std::vector<uint32_t>& PalInds) {
 		Patterns.resize(size(ColorPatterns));
 
-		for (auto i = 0; i < size(Map); ++i) {
+		for (auto i = 0; i < Map.GetHeight(); ++i) {
 			const auto PalInd = PalInds[PalInds[i]];
-			for (auto j : Map[i]) {
+			for (auto j : Map.GetRow(i)) {
 				if (!Patterns[j.PatternIndex].HasValidPaletteIndex()) {
 					ToIndexColorPattern(Patterns[j.PatternIndex], PalInd, ColorPatterns[j.PatternIndex]);
 				}
@@ -262,23 +1645,23 @@ public:
 		Patterns.resize(size(ColorPatterns));
 
 		auto k = 0;
-		for (auto i = 0; i < size(Map); i += 2) {
-			for (auto j = 0; j < size(Map[i]); j += 2) {
+		for (auto i = 0; i < Map.GetHeight(); i += 2) {
+			for (auto j = 0; j < Map.GetWidth(); j += 2) {
 				const auto PalInd = PalInds[PalInds[k++]];
 
-				auto PatInd = Map[i + 0][j + 0].PatternIndex;
+				auto PatInd = Map(i + 0, j + 0).PatternIndex;
 				if (!Patterns[PatInd].HasValidPaletteIndex()) {
 					ToIndexColorPattern(Patterns[PatInd], PalInd, ColorPatterns[PatInd]);
 				}
-				PatInd = Map[i + 0][j + 1].PatternIndex;
+				PatInd = Map(i + 0, j + 1).PatternIndex;
 				if (!Patterns[PatInd].HasValidPaletteIndex()) {
 					ToIndexColorPattern(Patterns[PatInd], PalInd, ColorPatterns[PatInd]);
 				}
-				PatInd = Map[i + 1][j + 0].PatternIndex;
+				PatInd = Map(i + 1, j + 0).PatternIndex;
 				if (!Patterns[PatInd].HasValidPaletteIndex()) {
 					ToIndexColorPattern(Patterns[PatInd], PalInd, ColorPatterns[PatInd]);
 				}
-				PatInd = Map[i + 1][j + 1].PatternIndex;
+				PatInd = Map(i + 1, j + 1).PatternIndex;
 				if (!Patterns[PatInd].HasValidPaletteIndex()) {
 					ToIndexColorPattern(Patterns[PatInd], PalInd, ColorPatterns[PatInd]);
 				}
@@ -286,46 +1669,75 @@ public:
 		}
 	}
 	virtual Converter& CreatePattern() {
-		std::vector<uint32_t> PaletteIndices(size(Palettes));
-		std::iota(begin(PaletteIndices), end(PaletteIndices), 0);
+		Trace::Scope Span("CreatePattern");
+		SourcePalettes = Palettes;
 
 		//!< pbg܂Ƃ߂
-		while ([&]() {
-			for (auto i = 0; i < size(Palettes); ++i) {
-				for (auto j = i + 1; j < size(Palettes); ++j) {
-					auto& lhs = Palettes[i];
-					auto& rhs = Palettes[j];
-					if (!empty(lhs) && !empty(rhs)) {
-						std::vector<uint32_t> Union;
-						std::ranges::set_union(lhs, rhs, std::back_inserter(Union));
-						//!< pbg̘aW pbg̃J[ȉɎ܂ꍇ́A̃pbgɂ܂Ƃ߂鎖\
-						if (GetPaletteColorCount() - GetPaletteReservedColorCount() > size(Union)) {
-							lhs.assign(begin(Union), end(Union));
-							rhs.clear();
-							std::ranges::replace(PaletteIndices, j, i);
-							return true;
-						}
-					}
+		//!< ^ꂽɁAaWpbg̃J[ȉɎ܂ŏ̃pbg֋l߂Ă (First Fit)
+		const auto MaxCount = static_cast<size_t>(GetPaletteColorCount() - GetPaletteReservedColorCount());
+		//!< aW̐F͏W OR  popcount ŋ܂
+		std::vector<ColorSet> Sets;
+		Sets.reserve(size(Palettes));
+		for (const auto& i : Palettes) {
+			Sets.emplace_back(i);
+		}
+		struct Packing {
+			std::vector<ColorSet> Packed;
+			std::vector<uint32_t> PackedFirst; //!< ܂Ƃ߂ꂽpbgԍ̍ŏl
+			std::vector<uint32_t> PackedIndices; //!< pbgԍ -> ܂Ƃ߂pbgԍ
+		};
+		const auto Pack = [&](const std::vector<uint32_t>& Order) {
+			Packing Pk;
+			Pk.PackedIndices.resize(size(Palettes));
+			for (const auto i : Order) {
+				const auto& Set = Sets[i];
+				const auto It = std::ranges::find_if(Pk.Packed, [&](const ColorSet& rhs) { return MaxCount > (rhs | Set).Count(); });
+				const auto Idx = static_cast<uint32_t>(std::distance(begin(Pk.Packed), It));
+				if (end(Pk.Packed) == It) {
+					Pk.Packed.emplace_back(Set);
+					Pk.PackedFirst.emplace_back(i);
 				}
+				else {
+					*It |= Set;
+					Pk.PackedFirst[Idx] = (std::min)(Pk.PackedFirst[Idx], i);
+				}
+				Pk.PackedIndices[i] = Idx;
 			}
-			return false;
-			}()) {
+			return Pk;
+		};
+		//!< ̏ (]̌ʂƓɂȂ) ƃJ[̑ (First Fit Decreasing) ̗ŋl߂āApbg̏Ȃ̗p
+		std::vector<uint32_t> Order(size(Palettes));
+		std::iota(begin(Order), end(Order), 0);
+		auto Pk = Pack(Order);
+		std::ranges::stable_sort(Order, [&](const uint32_t lhs, const uint32_t rhs) { return size(Palettes[lhs]) > size(Palettes[rhs]); });
+		if (auto PkDec = Pack(Order); size(PkDec.Packed) < size(Pk.Packed)) {
+			Pk = std::move(PkDec);
 		}
+		auto& [Packed, PackedFirst, PackedIndices] = Pk;
 
-		//!< pbgԍl߂
+		//!< pbgԍl߂ (̃pbgԍ̎Ⴂɕׂ)
+		std::vector<uint32_t> Ranks(size(Packed));
 		{
-			auto SortUnique = PaletteIndices;
-			std::ranges::sort(SortUnique);
-			const auto [B, E] = std::ranges::unique(SortUnique);
-			SortUnique.erase(B, E);
-			for (auto i = 0; i < size(SortUnique); ++i) {
-				std::ranges::replace(PaletteIndices, SortUnique[i], i);
+			std::vector<uint32_t> Sorted(size(Packed));
+			std::iota(begin(Sorted), end(Sorted), 0);
+			std::ranges::sort(Sorted, [&](const uint32_t lhs, const uint32_t rhs) { return PackedFirst[lhs] < PackedFirst[rhs]; });
+			for (auto i = 0; i < size(Sorted); ++i) {
+				Ranks[Sorted[i]] = i;
 			}
 		}
-		//!< ɂȂpbg͏
-		{
-			const auto [B, E] = std::ranges::remove_if(Palettes, [](const std::vector<uint32_t>& rhs) { return empty(rhs); });
-			Palettes.erase(B, E);
+		std::vector<uint32_t> PaletteIndices(size(Palettes));
+		for (auto i = 0; i < size(Palettes); ++i) {
+			PaletteIndices[i] = Ranks[PackedIndices[i]];
+		}
+		Palettes.resize(size(Packed));
+		for (auto i = 0; i < size(Packed); ++i) {
+			Palettes[Ranks[i]] = Packed[i].ToPalette();
+		}
+
+		//!< ܂ƂߏIpbgɋte[u
+		PaletteIndexTables.clear();
+		for (const auto& i : Palettes) {
+			PaletteIndexTables.emplace_back(CreateColorIndexTable(i));
 		}
 
 		//!< CfbNXJ[̃p^[쐬
@@ -341,23 +1753,116 @@ public:
 	}
 #pragma endregion
 
+#pragma region SNAPSHOT
+	static constexpr std::string_view SnapshotDirectory = "ImageConverter.cache";
+	static std::filesystem::path GetSnapshotPath(std::string_view Name) { return std::filesystem::path(SnapshotDirectory) / (std::string(Name) + ".tiles"); }
+
+	//!< ϊ̎ނƃo[WvȂ͓̂ǂ܂Ȃ
+	std::string GetSnapshotSignature() const {
+		return std::to_string(BuildManifest::ConverterVersion) + " " + typeid(*this).name() + " " + std::string(GetPlatformName()) + " " + std::to_string(sizeof(PatternEntity)) + " " + std::to_string(sizeof(Pattern));
+	}
+
+	void SaveSnapshot(std::string_view Name) {
+		const auto MapSize = GetMapSize();
+		//!< Ŝϊꍇ̓^C̃nbV߂Ă
+		if (size(TileHashes) != static_cast<size_t>(MapSize.area())) {
+			TileHashes.resize(MapSize.area());
+			for (auto i = 0; i < MapSize.height; ++i) {
+				for (auto j = 0; j < MapSize.width; ++j) {
+					PatternEntity Pat;
+					TileHashes[i * MapSize.width + j] = GetPatternHash(ToPlatformColorPattern(Pat, j * W, i * H));
+				}
+			}
+		}
+
+		std::vector<char> Bin;
+		const auto Write = [&](const auto* Ptr, const size_t Count) {
+			const auto Bytes = reinterpret_cast<const char*>(Ptr);
+			Bin.insert(end(Bin), Bytes, Bytes + Count * sizeof(*Ptr));
+		};
+		const auto WriteVector = [&](const auto& Vec) {
+			const auto Count = static_cast<uint64_t>(size(Vec));
+			Write(&Count, 1);
+			Write(data(Vec), size(Vec));
+		};
+		WriteVector(GetSnapshotSignature());
+		const int32_t Size[] = { MapSize.width, MapSize.height };
+		Write(Size, std::size(Size));
+		WriteVector(TileHashes);
+		WriteVector(Map.GetEntities());
+		WriteVector(ColorPatterns);
+		for (const auto Pals : { &SourcePalettes, &Palettes }) {
+			const auto Count = static_cast<uint64_t>(size(*Pals));
+			Write(&Count, 1);
+			for (const auto& i : *Pals) {
+				WriteVector(i);
+			}
+		}
+		WriteVector(Patterns);
+
+		std::error_code EC;
+		std::filesystem::create_directories(SnapshotDirectory, EC);
+		std::ofstream Out(GetSnapshotPath(Name), std::ios::binary | std::ios::out);
+		Out.write(data(Bin), size(Bin));
+	}
+	bool LoadSnapshot(std::string_view Name, Snapshot& Snap) const {
+		std::ifstream In(GetSnapshotPath(Name), std::ios::binary | std::ios::in);
+		if (In.fail()) { return false; }
+		const auto Read = [&](auto* Ptr, const size_t Count) {
+			return static_cast<bool>(In.read(reinterpret_cast<char*>(Ptr), Count * sizeof(*Ptr)));
+		};
+		const auto ReadVector = [&](auto& Vec) {
+			uint64_t Count = 0;
+			if (!Read(&Count, 1) || Count > (uint64_t(1) << 32)) { return false; }
+			Vec.resize(Count);
+			return 0 == Count || Read(data(Vec), Count);
+		};
+		std::string Signature;
+		if (!ReadVector(Signature) || GetSnapshotSignature() != Signature) { return false; }
+		int32_t Size[2];
+		if (!Read(Size, std::size(Size))) { return false; }
+		Snap.MapSize = cv::Size(Size[0], Size[1]);
+		if (!ReadVector(Snap.TileHashes) || !ReadVector(Snap.Map) || !ReadVector(Snap.ColorPatterns)) { return false; }
+		for (const auto Pals : { &Snap.SourcePalettes, &Snap.Palettes }) {
+			uint64_t Count = 0;
+			if (!Read(&Count, 1) || Count > (uint64_t(1) << 32)) { return false; }
+			Pals->resize(Count);
+			for (auto& i : *Pals) {
+				if (!ReadVector(i)) { return false; }
+			}
+		}
+		if (!ReadVector(Snap.Patterns)) { return false; }
+
+		//!< ꂽLbVŔ͈͊OǂݏȂ悤ASĂ̒l؂ (1 łsȂgȂ)
+		const auto ColorCount = GetPlatformColorCount();
+		const auto FlagCount = IsFlipSupported() ? 4u : 1u;
+		const auto IsValidColor = [&](const uint16_t rhs) { return rhs < ColorCount; };
+		const auto IsValidPalette = [&](const Palette& rhs) { return std::ranges::all_of(rhs, IsValidColor); };
+		if (size(Snap.Map) != size(Snap.TileHashes) || size(Snap.Patterns) != size(Snap.ColorPatterns)) { return false; }
+		if (!std::ranges::all_of(Snap.Map, [&](const MapEntity& rhs) { return rhs.PatternIndex < size(Snap.ColorPatterns) && rhs.Flags < FlagCount; })) { return false; }
+		if (!std::ranges::all_of(Snap.ColorPatterns, [&](const PatternEntity& rhs) { return std::ranges::all_of(rhs, [&](const auto& Row) { return std::ranges::all_of(Row, IsValidColor); }); })) { return false; }
+		if (!std::ranges::all_of(Snap.SourcePalettes, IsValidPalette) || !std::ranges::all_of(Snap.Palettes, IsValidPalette)) { return false; }
+		return std::ranges::all_of(Snap.Patterns, [&](const Pattern& rhs) {
+			if (rhs.PaletteIndex >= size(Snap.Palettes)) { return false; }
+			const auto PalSize = size(Snap.Palettes[rhs.PaletteIndex]);
+			return std::ranges::all_of(rhs.ColorIndices, [&](const auto& Row) { return std::ranges::all_of(Row, [&](const uint8_t i) { return i < PalSize; }); });
+		});
+	}
+#pragma endregion
+
 #pragma region OUTPUT
 	//!< ^w肵Ẵpbgo
 	template<typename T>
 	void OutputPaletteOfType(std::string_view Name) const {
-		std::cout << "\tPalette count = " << size(Palettes) << " / " << GetPaletteCount() << (size(Palettes) > GetPaletteCount() ? " warning" : "") << std::endl;
+		Console::Out() << "\tPalette count = " << size(Palettes) << " / " << GetPaletteCount() << (size(Palettes) > GetPaletteCount() ? " warning" : "") << std::endl;
 
-		std::ofstream OutBin(data(std::string(Name) + ".bin"), std::ios::binary | std::ios::out);
-		assert(!OutBin.bad());
-		std::ofstream OutText(data(std::string(Name) + ".txt"), std::ios::out);
-		assert(!OutText.bad());
+		OutputBuffer Out(Name);
 
-		//OutText << "const " << typeid(T).name() << " " << Name << "[] = {" << std::endl;
-		OutText << "const u" << (sizeof(T) << 3) << " " << Name << "[] = {" << std::endl;
+		Out.Header<T>(Name);
 
 		for (auto i : Palettes) {
 			const auto MaxCount = GetPaletteColorCount() - GetPaletteReservedColorCount();
-			std::cout << "\t\tPalette color count = " << size(i) << " / " << MaxCount << (size(i) > MaxCount ? " warning" : "" ) << std::endl;
+			Console::Out() << "\t\tPalette color count = " << size(i) << " / " << MaxCount << (size(i) > MaxCount ? " warning" : "" ) << std::endl;
 
 			const T TransparentColor = 0; //!< 擪F (ł 0 ƂĂ)
 
@@ -376,63 +1881,110 @@ public:
 			}
 
 			//!< o
-			OutText << "\t";
+			Out << "\t";
 			for (auto j = 0; j < size(PalOut); ++j) {
-				OutText << "0x" << std::hex << std::setw(sizeof(PalOut[j]) << 1) << std::right << std::setfill('0') << static_cast<uint16_t>(PalOut[j]);
-				if (size(PalOut) - 1 > j) { OutText << ", "; }
+				Out.Hex(PalOut[j]);
+				if (size(PalOut) - 1 > j) { Out << ", "; }
 			}
-			OutText << std::endl;
+			Out << "\n";
 
-			OutBin.write(reinterpret_cast<const char*>(data(PalOut)), size(PalOut) * sizeof(PalOut[0]));
+			Out.Write(PalOut);
 		}
-		OutText << "};" << std::endl;
+		Out.Footer();
 
-		OutBin.close();
-		OutText.close();
+		Out.Close();
+	}
+	//!< ^w肵Ẵp^[o
+	//!< eLXg GroupSize Ƀ^uAGroupSize * GroupsPerLine ɉs
+	template<typename T>
+	void OutputPatternOfType(std::string_view Name, const std::vector<T>& Words, const size_t GroupSize, const size_t GroupsPerLine) const {
+		OutputBuffer Out(Name);
+		Out.Reserve(size(Words) * ((sizeof(T) << 1) + 5), size(Words) * sizeof(T));
+
+		Out.Header<T>(Name);
+		for (auto i = 0; i < size(Words); ++i) {
+			if (0 == i % GroupSize) { Out << "\t"; }
+			Out.Hex(Words[i]);
+			if (size(Words) - 1 > i) { Out << ", "; }
+			if (0 == (i + 1) % (GroupSize * GroupsPerLine)) { Out << "\n"; }
+		}
+		Out.Footer();
+
+		Out.Write(Words);
+
+		Out.Close();
 	}
 	virtual const Converter& OutputPalette(std::string_view Name) const { return *this; }
 	virtual const Converter& OutputPattern(std::string_view Name) const { return *this; }
 	virtual const Converter& OutputMap(std::string_view Name) const {
-		std::cout << "\tMap size = " << size(this->Map[0]) << " x " << size(this->Map) << std::endl;
+		Trace::Scope Span("OutputMap");
+		Console::Out() << "\tMap size = " << this->Map.GetWidth() << " x " << this->Map.GetHeight() << std::endl;
 
-		std::ofstream OutBin(data(std::string(Name) + ".bin"), std::ios::binary | std::ios::out);
-		assert(!OutBin.bad());
-		std::ofstream OutText(data(std::string(Name) + ".txt"), std::ios::out);
-		assert(!OutText.bad());
+		OutputBuffer Out(Name);
+		Out.Reserve(this->Map.GetHeight() * this->Map.GetWidth() * 7, this->Map.GetHeight() * this->Map.GetWidth());
 
-		//OutText << "const " << typeid(uint8_t).name() << " " << Name << "[] = {" << std::endl;
-		OutText << "const u" << (sizeof(uint8_t) << 3) << " " << Name << "[] = {" << std::endl;
+		Out.Header<uint8_t>(Name);
 
-		for (auto i = 0; i < size(this->Map); ++i) {
-			OutText << "\t";
-			for (auto j = 0; j < size(this->Map[i]); ++j) {
-				const auto PatIdx8 = static_cast<uint8_t>(this->Map[i][j].PatternIndex);
+		for (auto i = 0; i < this->Map.GetHeight(); ++i) {
+			Out << "\t";
+			for (auto j = 0; j < this->Map.GetWidth(); ++j) {
+				const auto PatIdx8 = static_cast<uint8_t>(this->Map(i, j).PatternIndex);
 
-				OutText << "0x" << std::hex << std::setw(sizeof(PatIdx8) << 1) << std::right << std::setfill('0') << static_cast<uint16_t>(PatIdx8);
-				if (size(this->Map) - 1 > i || size(this->Map[i]) - 1 > j) { OutText << ", "; }
+				Out.Hex(PatIdx8);
+				if (this->Map.GetHeight() - 1 > i || this->Map.GetWidth() - 1 > j) { Out << ", "; }
 
-				OutBin.write(reinterpret_cast<const char*>(&PatIdx8), sizeof(PatIdx8));
+				Out.Write(PatIdx8);
 			}
-			OutText << std::endl;
+			Out << "\n";
 		}
-		OutText << "};" << std::endl;
+		Out.Footer();
 
-		OutBin.close();
-		OutText.close();
+		Out.Close();
 
 		return *this;
 	}
 	virtual const Converter& OutputBAT(std::string_view Name) const { return *this; }
-	virtual const Converter& OutputAnimation(std::string_view Path) const {
-		std::cout << "\tSprite count = " << size(Map) << std::endl;
-		std::cout << "\tMax animation count = " << size(Map[0]) << std::endl;
-		for (const auto& r : Map) {
-			std::cout << "\t\tSprite animations = ";
-			for (const auto& c : r) {
-				std::cout << c.PatternIndex << ", ";
+	//!< Aj[Ve[u (sXvCgA񂪃Aj[Ṽt[)  Name.anim ֏o͂
+	//!< ]Ĉvt[̓p^[L̂ŁA]ƍ킹ďo͂Ac[ŕł悤ɂ
+	//!<	u16 VHPPPPPP PPPPPPPP
+	//!<	P : p^[ԍ [0, 16383]AH : ]AV : ]
+	virtual const Converter& OutputAnimation(std::string_view Name) const {
+		Trace::Scope Span("OutputAnimation");
+		Console::Out() << "\tSprite count = " << Map.GetHeight() << std::endl;
+		Console::Out() << "\tMax animation count = " << Map.GetWidth() << std::endl;
+
+		const auto AnimName = std::string(Name) + ".anim";
+		OutputBuffer Out(AnimName);
+		Out.Reserve(Map.GetHeight() * Map.GetWidth() * 8, Map.GetHeight() * Map.GetWidth() * sizeof(uint16_t));
+
+		Out.Header<uint16_t>(std::string(Name) + "_ANIM");
+		for (auto i = 0; i < Map.GetHeight(); ++i) {
+			Console::Out() << "\t\tSprite animations = ";
+			Out << "\t";
+			for (auto j = 0; j < Map.GetWidth(); ++j) {
+				const auto& c = Map(i, j);
+				Console::Out() << c.PatternIndex;
+				//!< ] (H : ]AV : ])
+				if (c.Flags & MapEntity::FLIP_H) { Console::Out() << "H"; }
+				if (c.Flags & MapEntity::FLIP_V) { Console::Out() << "V"; }
+				Console::Out() << ", ";
+
+				if (c.PatternIndex > 0x3fff) {
+					Console::Err() << "\tPattern index " << c.PatternIndex << " > " << 0x3fff << std::endl;
+				}
+				const auto Anim = static_cast<uint16_t>((c.Flags << 14) | (c.PatternIndex & 0x3fff));
+				Out.Hex(Anim);
+				if (Map.GetHeight() - 1 > i || Map.GetWidth() - 1 > j) { Out << ", "; }
+
+				Out.Write(Anim);
 			}
-			std::cout << std::endl;
+			Console::Out() << std::endl;
+			Out << "\n";
 		}
+		Out.Footer();
+
+		Out.Close();
+
 		return *this;
 	}
 #pragma endregion
@@ -478,18 +2030,18 @@ public:
 #ifdef _DEBUG
 		cv::Mat Res(Image.size(), Image.type());
 
-		for (auto r = 0; r < size(Map); ++r) {
-			for (auto c = 0; c < size(Map[r]); ++c) {
-				const auto& MapEnt = Map[r][c];
+		for (auto r = 0; r < Map.GetHeight(); ++r) {
+			for (auto c = 0; c < Map.GetWidth(); ++c) {
+				const auto& MapEnt = Map(r, c);
 
 				const auto& Pat = Patterns[MapEnt.PatternIndex];
 				assert(Pat.HasValidPaletteIndex());
-				//MapEnt.Flags; //!< ]
 
 				cv::Mat cvPat(cv::Size(W, H), Image.type());
 				for (auto i = 0; i < size(Pat.ColorIndices); ++i) {
 					for (auto j = 0; j < size(Pat.ColorIndices[i]); ++j) {
-						cvPat.ptr<cv::Vec3b>(i)[j] = FromPlatformColor(Palettes[Pat.PaletteIndex][Pat.ColorIndices[i][j]]);
+						//!< ]l
+						cvPat.ptr<cv::Vec3b>(i)[j] = FromPlatformColor(Palettes[Pat.PaletteIndex][GetFlipped(Pat.ColorIndices, MapEnt.Flags, i, j)]);
 					}
 				}
 				cvPat.copyTo(Res(cv::Rect(c * W, r * H, W, H)));
@@ -505,103 +2057,823 @@ public:
 
 protected:
 	const cv::Mat& Image;
+	std::vector<uint16_t> ColorPlane; //!< 摜ŜvbgtH[J[֕ϊ
 	std::vector<PatternEntity> ColorPatterns;
+	//!< p^[̃nbV ColorPatterns ̃CfbNX
+	std::unordered_multimap<size_t, uint32_t> ColorPatternIndices;
+	std::vector<size_t> TileHashes; //!< ^C̃nbV (XVp)
+
+	MapGrid Map;
+	std::vector<Palette> SourcePalettes; //!< ܂Ƃ߂Õpbg (XVp)
+	std::vector<Palette> Palettes;
+	std::vector<ColorIndexTable> PaletteIndexTables; //!< Palettes ̋te[u
+	std::vector<Pattern> Patterns;
+};
+
+//!< fBNg̃t@C̕ύX҂ (Linux  inotifyAWindows  ReadDirectoryChangesWAȊO̓|[O)
+//!< TufBNg͊ĎȂ̂ŁAKvȃfBNg Add() Œǉ
+class DirectoryWatcher
+{
+public:
+	DirectoryWatcher(std::string_view Path) {
+#if defined(__linux__)
+		FD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+		Add(Path);
+	}
+	~DirectoryWatcher() {
+#ifdef _WIN32
+		for (auto& [Dir, W] : Watches) {
+			if (W.Pending) { CancelIo(W.Handle); }
+			CloseHandle(W.Overlapped.hEvent);
+			CloseHandle(W.Handle);
+		}
+#elif defined(__linux__)
+		if (-1 != FD) { close(FD); }
+#endif
+	}
+
+	//!< ĎfBNgǉ (Ďς݂Ȃ牽Ȃ)
+	void Add(std::string_view Path) {
+		const auto Dir = GetDirectory(Path);
+#ifdef _WIN32
+		if (Watches.contains(Dir)) { return; }
+		if (MAXIMUM_WAIT_OBJECTS <= size(Watches)) {
+			Console::Err() << "Too many directories to watch, " << Dir << " is ignored" << std::endl;
+			return;
+		}
+		const auto Handle = CreateFileA(data(Dir), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+		if (INVALID_HANDLE_VALUE == Handle) { return; }
+		//!< OVERLAPPED ̃AhXςȂ悤A}bṽm[hɒڍ\z
+		auto& W = Watches[Dir];
+		W.Handle = Handle;
+		W.Overlapped.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+#elif defined(__linux__)
+		if (-1 == FD) { return; }
+		//!< fBNgɂ͓LqqԂ
+		if (const auto WD = inotify_add_watch(FD, data(Dir), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE); -1 != WD) {
+			Directories[WD] = Dir;
+		}
+#else
+		if (Directories.emplace(Dir).second) {
+			Scan(Dir, Times);
+		}
+#endif
+	}
+
+	//!< ύX邩 Timeout (~bAȂ疳) ߂܂ő҂AύXꂽt@C̃tpX Names ֒ǉ
+	//!< ĎłȂȂ false
+	bool Wait(std::vector<std::string>& Names, const int Timeout) {
+#ifdef _WIN32
+		if (empty(Watches)) { return false; }
+		std::vector<HANDLE> Events;
+		for (auto& [Dir, W] : Watches) {
+			if (!W.Pending) {
+				if (!ReadDirectoryChangesW(W.Handle, data(W.Buffer), static_cast<DWORD>(size(W.Buffer)), FALSE, FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE, nullptr, &W.Overlapped, nullptr)) { return false; }
+				W.Pending = true;
+			}
+			Events.emplace_back(W.Overlapped.hEvent);
+		}
+		if (WAIT_TIMEOUT == WaitForMultipleObjects(static_cast<DWORD>(size(Events)), data(Events), FALSE, 0 > Timeout ? INFINITE : static_cast<DWORD>(Timeout))) { return true; }
+		for (auto& [Dir, W] : Watches) {
+			if (WAIT_OBJECT_0 != WaitForSingleObject(W.Overlapped.hEvent, 0)) { continue; }
+			W.Pending = false;
+			DWORD Bytes = 0;
+			if (!GetOverlappedResult(W.Handle, &W.Overlapped, &Bytes, FALSE)) { return false; }
+			ResetEvent(W.Overlapped.hEvent);
+			for (auto Offset = 0ul; 0 < Bytes;) {
+				const auto Info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(data(W.Buffer) + Offset);
+				const std::wstring Name(Info->FileName, Info->FileNameLength / sizeof(WCHAR));
+				Names.emplace_back((std::filesystem::path(Dir) / Name).lexically_normal().string());
+				if (0 == Info->NextEntryOffset) { break; }
+				Offset += Info->NextEntryOffset;
+			}
+		}
+		return true;
+#elif defined(__linux__)
+		if (-1 == FD || empty(Directories)) { return false; }
+		pollfd PFD = { .fd = FD, .events = POLLIN };
+		if (0 >= poll(&PFD, 1, Timeout)) { return true; }
+		alignas(inotify_event) std::array<char, 4096> Buf;
+		for (auto Len = read(FD, data(Buf), size(Buf)); 0 < Len; Len = read(FD, data(Buf), size(Buf))) {
+			for (auto Ptr = data(Buf); Ptr < data(Buf) + Len;) {
+				const auto Event = reinterpret_cast<const inotify_event*>(Ptr);
+				if (const auto It = Directories.find(Event->wd); 0 < Event->len && end(Directories) != It) {
+					Names.emplace_back((std::filesystem::path(It->second) / Event->name).lexically_normal().string());
+				}
+				Ptr += sizeof(inotify_event) + Event->len;
+			}
+		}
+		return true;
+#else
+		//!< XVIɔr
+		const auto Start = std::chrono::steady_clock::now();
+		do {
+			std::unordered_map<std::string, std::filesystem::file_time_type> Current;
+			for (const auto& i : Directories) {
+				Scan(i, Current);
+			}
+			for (const auto& [Name, Time] : Current) {
+				if (const auto It = Times.find(Name); end(Times) == It || It->second != Time) {
+					Names.emplace_back(Name);
+				}
+			}
+			Times.swap(Current);
+			if (!empty(Names)) { break; }
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		} while (0 > Timeout || std::chrono::steady_clock::now() - Start < std::chrono::milliseconds(Timeout));
+		return true;
+#endif
+	}
+
+	//!< tpXɂĐK ("." Ȃǂ̋؂蕶ƂĎcȂ悤ɈxtĂe)
+	static std::string GetDirectory(std::string_view Path) {
+		return (std::filesystem::absolute(Path).lexically_normal() / "").parent_path().string();
+	}
+
+private:
+#ifdef _WIN32
+	struct Watch
+	{
+		HANDLE Handle = INVALID_HANDLE_VALUE;
+		OVERLAPPED Overlapped = {};
+		alignas(DWORD) std::array<char, 16384> Buffer;
+		bool Pending = false;
+	};
+	std::map<std::string, Watch> Watches; //!< fBNg
+#elif defined(__linux__)
+	int FD = -1;
+	std::unordered_map<int, std::string> Directories; //!< ĎLqqfBNg
+#else
+	static void Scan(const std::string& Directory, std::unordered_map<std::string, std::filesystem::file_time_type>& Dst) {
+		std::error_code EC;
+		for (const auto& i : std::filesystem::directory_iterator(Directory, EC)) {
+			if (i.is_regular_file(EC)) {
+				Dst[i.path().lexically_normal().string()] = i.last_write_time(EC);
+			}
+		}
+	}
+	std::unordered_set<std::string> Directories;
+	std::unordered_map<std::string, std::filesystem::file_time_type> Times;
+#endif
+};
+
+//!< t@CǂݍݐpŃփ}bv (Linux  mmapAWindows  MapViewOfFileAȊO͑Ŝǂݍ)
+class MappedFile
+{
+public:
+	MappedFile(const std::filesystem::path& Path) {
+#ifdef _WIN32
+		const auto File = CreateFileW(Path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (INVALID_HANDLE_VALUE == File) { return; }
+		LARGE_INTEGER FileSize = {};
+		if (GetFileSizeEx(File, &FileSize) && 0 < FileSize.QuadPart) {
+			//!< }bv (r[cĂ) nh͕ėǂ
+			if (const auto Mapping = CreateFileMappingW(File, nullptr, PAGE_READONLY, 0, 0, nullptr); nullptr != Mapping) {
+				View = MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0);
+				if (nullptr != View) {
+					Data = static_cast<const char*>(View);
+					Size = static_cast<size_t>(FileSize.QuadPart);
+				}
+				CloseHandle(Mapping);
+			}
+		}
+		CloseHandle(File);
+#elif defined(__linux__)
+		const auto FD = open(Path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (-1 == FD) { return; }
+		struct stat Stat = {};
+		if (0 == fstat(FD, &Stat) && 0 < Stat.st_size) {
+			if (const auto Ptr = mmap(nullptr, static_cast<size_t>(Stat.st_size), PROT_READ, MAP_PRIVATE, FD, 0); MAP_FAILED != Ptr) {
+				View = Ptr;
+				Data = static_cast<const char*>(Ptr);
+				Size = static_cast<size_t>(Stat.st_size);
+			}
+		}
+		close(FD);
+#else
+		std::ifstream In(Path, std::ios::in | std::ios::binary);
+		if (!In.fail()) {
+			Content.assign(std::istreambuf_iterator<char>(In), std::istreambuf_iterator<char>());
+			Data = data(Content);
+			Size = size(Content);
+		}
+#endif
+	}
+	~MappedFile() {
+#ifdef _WIN32
+		if (nullptr != View) { UnmapViewOfFile(View); }
+#elif defined(__linux__)
+		if (nullptr != View) { munmap(View, Size); }
+#endif
+	}
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	//!< t@C̓e (t@CJȂꍇ͋)
+	std::string_view GetView() const { return { Data, Size }; }
+
+private:
+	const char* Data = nullptr;
+	size_t Size = 0;
+#if defined(_WIN32) || defined(__linux__)
+	void* View = nullptr;
+#else
+	std::string Content;
+#endif
+};
+
+//!< .res sɍڂ֕Aڂ͌̓ew std::string_view Ȃ̂ŃRs[Ȃ
+//!< ڂ̋؂͋ (Xy[XA^uACR)A" ň͂ނƋ󔒂܂ލڂɂȂ (" ͊܂܂Ȃ)
+class ResTokenizer
+{
+public:
+	struct Line
+	{
+		std::string_view Text; //!< sS (s͊܂܂Ȃ)
+		std::vector<std::string_view> Items;
+		uint32_t Number = 0; //!< sԍ (1 )
+		uint32_t Column = 0; //!< G[ʒu̗ (1 )
+		std::string_view Error; //!< G[̏ꍇ͂̓e (Items ͋ɂȂ)
+	};
+
+	ResTokenizer(std::string_view Src) : Source(Src) {
+		//!< UTF-8  BOM ͓ǂݔ΂
+		if (Source.starts_with("\xef\xbb\xbf")) { Source.remove_prefix(3); }
+	}
+
+	//!< ̍s Ln ֓ǂݍށAI[Ȃ false
+	bool Next(Line& Ln) {
+		if (Position >= size(Source)) { return false; }
+		const auto End = std::min(Source.find('\n', Position), size(Source));
+		Ln.Text = Source.substr(Position, End - Position);
+		Ln.Items.clear();
+		Ln.Number = ++LineNumber;
+		Ln.Column = 0;
+		Ln.Error = {};
+		Position = End + 1;
+
+		const auto& T = Ln.Text;
+		constexpr std::string_view Spaces = " \t\r";
+		for (auto i = T.find_first_not_of(Spaces); std::string_view::npos != i; i = T.find_first_not_of(Spaces, i)) {
+			if ('"' == T[i]) {
+				const auto Close = T.find('"', i + 1);
+				if (std::string_view::npos == Close) {
+					return SetError(Ln, i, "Unterminated quoted item");
+				}
+				if (Close + 1 < size(T) && std::string_view::npos == Spaces.find(T[Close + 1])) {
+					return SetError(Ln, Close + 1, "Missing separator after quoted item");
+				}
+				Ln.Items.emplace_back(T.substr(i + 1, Close - i - 1));
+				i = Close + 1;
+			}
+			else {
+				const auto Last = std::min(T.find_first_of(Spaces, i), size(T));
+				if (const auto Quote = T.find('"', i); Quote < Last) {
+					return SetError(Ln, Quote, "Unexpected quote in item");
+				}
+				Ln.Items.emplace_back(T.substr(i, Last - i));
+				i = Last;
+			}
+		}
+		return true;
+	}
+
+private:
+	static bool SetError(Line& Ln, const size_t Offset, std::string_view Message) {
+		Ln.Items.clear();
+		Ln.Column = static_cast<uint32_t>(Offset + 1);
+		Ln.Error = Message;
+		return true;
+	}
+
+	std::string_view Source;
+	size_t Position = 0;
+	uint32_t LineNumber = 0;
+};
+
+class ResourceReaderBase
+{
+public:
+	ResourceReaderBase() {
+		//!< LOG_LEVEL_INFO  gtk ̗]vȃOoĂ̂
+		cv::utils::logging::setLogLevel(cv::utils::logging::LOG_LEVEL_WARNING);
+	}
+
+	void Read(std::string_view Path, const uint32_t JobCount = 1, const bool Rebuild = false) {
+		std::filesystem::current_path(Path);
+		Trace::Reset();
+
+		BuildManifest Manifest;
+		if (!Rebuild) {
+			Manifest.Load();
+		}
+		Sources.clear();
+
+		//!< GgW߂ (Collect entries)
+		struct Entry
+		{
+			std::string Res;
+			std::vector<std::string> Items; //!<  (.res ̃}bv͓ǂݏI̂ŃRs[Ď)
+			std::string Key;
+			BuildManifest::Record Record;
+			bool Dirty = true;
+		};
+		std::vector<Entry> Entries;
+		for (const auto& i : std::filesystem::directory_iterator(std::filesystem::current_path())) {
+			if (!i.is_directory()) {
+				//!< .res t@CT (Search for .res files)
+				if (i.path().has_extension() && ".res" == i.path().extension().string()) {
+					Entries.emplace_back(Entry({ .Res = std::filesystem::absolute(i.path()).string() }));
+					//!< ڂ̓}bveŵŁAGgփRs[炷ɕ ( .res Ăǂ悤)
+					const MappedFile File(std::filesystem::absolute(i.path()));
+					const auto ResName = i.path().filename().string();
+					//!< sǂݍ݁Aڂɕ (Read line and split into items)
+					ResTokenizer Tokenizer(File.GetView());
+					ResTokenizer::Line Ln;
+					while (Tokenizer.Next(Ln)) {
+						if (!empty(Ln.Error)) {
+							Console::Err() << ResName << "(" << Ln.Number << "," << Ln.Column << ") : " << Ln.Error << std::endl;
+							continue;
+						}
+						if (!empty(Ln.Items)) {
+							Entries.emplace_back(Entry({ .Res = ResName, .Items = std::vector<std::string>(begin(Ln.Items), end(Ln.Items)), .Key = BuildManifest::GetKey(ResName, Ln.Text) }));
+						}
+					}
+				}
+			}
+		}
+
+		//!< REDUCE w肵摜W߂ (摜QƂSẴGgFʂg)
+		Reductions.clear();
+		for (const auto& i : Entries) {
+			const auto Option = GetReduceOption(i.Items);
+			const auto Func = empty(Option) ? nullptr : GetReduceFunc(i.Items[0]);
+			if (nullptr == Func) { continue; }
+			const auto [It, Inserted] = Reductions.try_emplace(std::filesystem::path(i.Items[2]).lexically_normal().string(), Reduction({ .Type = std::string(i.Items[0]), .Option = std::string(Option), .Func = Func }));
+			if (!Inserted && (It->second.Func != Func || It->second.Option != Option)) {
+				Console::Err() << i.Res << " : Conflicting REDUCE for " << i.Items[2] << " (" << It->second.Type << " " << It->second.Option << " is used)" << std::endl;
+			}
+		}
+
+		//!< ŐL^ƔׂĕύX̗L𒲂ׂ
+		for (auto& i : Entries) {
+			if (empty(i.Items)) { continue; }
+			const auto Source = size(i.Items) > 2 ? i.Items[2] : "";
+			const auto Normal = std::filesystem::path(Source).lexically_normal().string();
+			Sources.emplace(std::filesystem::absolute(Normal).lexically_normal().string());
+			i.Record = Manifest.CreateRecord(GetPlatformName(), Source);
+			if (const auto It = Reductions.find(Normal); end(Reductions) != It) {
+				i.Record.Reduce = It->second.GetKey();
+			}
+			i.Dirty = !Manifest.IsUpToDate(i.Key, i.Record);
+		}
+
+		//!< ̏o͂Gg 1 łύXΑSď (̃Gg㏑ʂɂ邽)
+		std::unordered_set<std::string> DirtyNames;
+		for (const auto& i : Entries) {
+			if (!empty(i.Items) && i.Dirty) {
+				DirtyNames.emplace(size(i.Items) > 1 ? i.Items[1] : "");
+			}
+		}
+
+		//!< ύX̂GgɃWu쐬A܂Ƃ߂ď
+		BuildManifest Next;
+		std::vector<Job> Jobs;
+		std::vector<size_t> JobEntries;
+		for (size_t i = 0; i < size(Entries); ++i) {
+			auto& Ent = Entries[i];
+			if (empty(Ent.Items)) {
+				Jobs.emplace_back(Job({ "", [Res = Ent.Res]() { Console::Out() << Res << std::endl; } }));
+				JobEntries.emplace_back(i);
+				continue;
+			}
+			const auto Name = std::string(size(Ent.Items) > 1 ? Ent.Items[1] : "");
+			if (DirtyNames.contains(Name)) {
+				//!< ϊʂ͉摜QƂŌ̃GgIj (OŔꍇ)
+				const auto Source = size(Ent.Items) > 2 ? Ent.Items[2] : "";
+				Converted.AddUser(Source);
+				Jobs.emplace_back(Job({ Name, [this, Items = Ent.Items, Source]() {
+					const ScopeExit Release([&]() { Converted.Release(Source); });
+					ProcessItems(Items);
+				} }));
+				JobEntries.emplace_back(i);
+			}
+			else {
+				Jobs.emplace_back(Job({ "", [Name]() { Console::Out() << "[ Up to date ] " << Name << std::endl; } }));
+				JobEntries.emplace_back(i);
+				Next.Records[Ent.Key] = Manifest.Records[Ent.Key];
+			}
+		}
+		Run(Jobs, JobCount);
+		Converted.Clear();
+
+		//!< Gg̏o͂L^
+		for (size_t i = 0; i < size(Jobs); ++i) {
+			auto& Ent = Entries[JobEntries[i]];
+			if (!empty(Jobs[i].Name) && !Jobs[i].Failed) {
+				auto& Rec = Next.Records[Ent.Key] = Ent.Record;
+				for (const auto& j : Jobs[i].Outputs) {
+					Rec.Outputs.emplace_back(BuildManifest::FileStamp::Get(j));
+				}
+			}
+		}
+		Next.Save();
+
+		Trace::Write();
+	}
+
+	//!< Path ĎA.res t@CQƂĂ摜ύXꂽǂݍݒ
+	//!< ύX̖Gg̓}jtFXgɂXLbvA摜̃LbVvZXɎc
+	void Watch(std::string_view Path, const uint32_t JobCount = 1, const bool Rebuild = false) {
+		const auto Directory = std::filesystem::absolute(Path).lexically_normal().string();
+		DirectoryWatcher Watcher(Directory);
+		const auto ResDirectory = DirectoryWatcher::GetDirectory(Directory);
+		//!< 摜̓TufBNgʂ̏ꏊɂ邱Ƃ̂ŁA摜̂fBNgĎ
+		const auto AddSources = [&]() {
+			for (const auto& i : Sources) {
+				Watcher.Add(std::filesystem::path(i).parent_path().string());
+			}
+		};
+		Read(Directory, JobCount, Rebuild);
+		AddSources();
+		Console::Out() << "Watching " << Directory << std::endl;
+
+		std::vector<std::string> Names;
+		while (Watcher.Wait(Names, -1)) {
+			//!< Names, Sources ɃtpXŔׂ
+			const auto IsRelevant = [&](const std::string& rhs) {
+				const auto Name = std::filesystem::path(rhs);
+				return (".res" == Name.extension().string() && ResDirectory == Name.parent_path().string()) || Sources.contains(rhs);
+			};
+			if (std::ranges::any_of(Names, IsRelevant)) {
+				//!< ۑ݂̏ɂȂ邱Ƃ̂ŁAύX܂ŏ҂
+				for (auto Count = size(Names); Watcher.Wait(Names, 20) && Count != size(Names); Count = size(Names)) {}
+				const auto Start = std::chrono::steady_clock::now();
+				Read(Directory, JobCount);
+				AddSources();
+				Console::Out() << "Updated in " << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - Start).count() << " ms" << std::endl;
+			}
+			Names.clear();
+		}
+	}
+
+	//!< Read() ̌ɌĂԁAJgfBNg (Read() ňړ\[XtH_)  .res  MAP, IMAP ɂ
+	//!< o͂ .bin (}bvAp^[Apbg) 摜𕜌A摜Ɣr (vr[\ɍςނ̂ CI )
+	//!< REDUCE w肵摜͕ϊƓF̉摜Ɣr
+	//!< pbg͓摜QƂĂ PALETTE Gg̏o͂gAsv false
+	bool Verify(const uint32_t JobCount = 1) {
+		std::unordered_map<std::string, std::string> PaletteNames; //!< 摜 PALETTE Gg (ŏ̂)
+		std::vector<VerifyEntry> Entries;
+		for (const auto& i : std::filesystem::directory_iterator(std::filesystem::current_path())) {
+			if (!i.is_directory() && i.path().has_extension() && ".res" == i.path().extension().string()) {
+				//!< ͂̃G[ Read() ŏo͍ς
+				const MappedFile File(i.path());
+				ResTokenizer Tokenizer(File.GetView());
+				ResTokenizer::Line Ln;
+				while (Tokenizer.Next(Ln)) {
+					const auto& Items = Ln.Items;
+					if (size(Items) < 3) { continue; }
+					if ("PALETTE" == Items[0]) {
+						PaletteNames.try_emplace(std::filesystem::path(Items[2]).lexically_normal().string(), Items[1]);
+					}
+					if (("MAP" == Items[0] || "IMAP" == Items[0]) && size(Items) > 3) {
+						Entries.emplace_back(VerifyEntry({ .Type = std::string(Items[0]), .Name = std::string(Items[1]), .File = std::string(Items[2]), .TileSet = std::string(Items[3]) }));
+					}
+				}
+			}
+		}
+		for (auto& i : Entries) {
+			if (const auto It = PaletteNames.find(std::filesystem::path(i.File).lexically_normal().string()); end(PaletteNames) != It) {
+				i.Palette = It->second;
+			}
+		}
+
+		//!< GgɕɌ؂ (OŏÎ FAIL ̂܂)
+		std::vector<VERIFY> Results(size(Entries), VERIFY::FAIL);
+		std::vector<Job> Jobs;
+		for (size_t i = 0; i < size(Entries); ++i) {
+			Jobs.emplace_back(Job({ "", [&, i]() {
+				const auto& Ent = Entries[i];
+				Trace::Scope Span([&]() { return "VERIFY " + Ent.Name; }, "entry");
+				Console::Out() << "[ Verify ] " << Ent.Name << " (" << Ent.File << ")" << std::endl;
+				Results[i] = VerifyMap(Ent);
+			} }));
+		}
+		Run(Jobs, JobCount);
+
+		const auto Failed = std::ranges::count(Results, VERIFY::FAIL);
+		Console::Out() << "Verified = " << std::ranges::count(Results, VERIFY::PASS) << ", Failed = " << Failed << ", Skipped = " << std::ranges::count(Results, VERIFY::SKIP) << std::endl;
+
+		Trace::Write();
+
+		return 0 == Failed;
+	}
+
+	//!< }jtFXgɋL^vbgtH[
+	virtual std::string_view GetPlatformName() const { return ""; }
+
+protected:
+	std::unordered_set<std::string> Sources; //!< .res QƂĂ摜 (tpX)
+	ConvertedCache Converted; //!< GgԂŋLϊ (摜QƂŌ̃Gg̏I܂ŕێ)
+
+	struct Job
+	{
+		std::string Name; //!< o͖ (̃Wu͋Lqɓ[J[ŏ)
+		std::function<void()> Func;
+		std::ostringstream Out;
+		std::ostringstream Err;
+		std::vector<std::string> Outputs; //!< ot@C
+		bool Failed = false;
+	};
+
+	//!< Wus (łł)AO̓G[o͂֏ăWu̎sƂċL^A𑱂
+	static void Invoke(Job& J) {
+		OutputBuffer::Written = &J.Outputs;
+		try {
+			J.Func();
+		}
+		catch (const std::exception& e) {
+			Console::Err() << e.what() << std::endl;
+			J.Failed = true;
+		}
+		catch (...) {
+			Console::Err() << "Unknown exception" << std::endl;
+			J.Failed = true;
+		}
+		OutputBuffer::Written = nullptr;
+	}
+	//!< Wu JobCount ̃[J[ŏ (0 Ȃn[hEFAXbh)
+	//!< R\[o͂̓WuɃobt@OALqɏo͂
+	static void Run(std::vector<Job>& Jobs, uint32_t JobCount) {
+		if (0 == JobCount) {
+			JobCount = (std::max)(std::thread::hardware_concurrency(), 1u);
+		}
+		if (1 == JobCount) {
+			Parallel::WorkerCount = 1;
+			for (auto& i : Jobs) {
+				Invoke(i);
+			}
+			return;
+		}
+
+		//!< ̃Wu͂ЂƂ܂Ƃ߂ɂ (t@Cւ̏o͏𒀎Ɠɂ邽)
+		std::vector<std::vector<size_t>> Groups;
+		std::unordered_map<std::string, size_t> GroupIndices;
+		for (size_t i = 0; i < size(Jobs); ++i) {
+			if (empty(Jobs[i].Name)) {
+				Groups.emplace_back(std::vector<size_t>({ i }));
+			}
+			else {
+				const auto [It, Inserted] = GroupIndices.try_emplace(Jobs[i].Name, size(Groups));
+				if (Inserted) {
+					Groups.emplace_back();
+				}
+				Groups[It->second].emplace_back(i);
+			}
+		}
+
+		std::mutex Mutex;
+		std::condition_variable Condition;
+		std::vector<bool> Done(size(Jobs), false);
+		std::atomic<size_t> Next = 0;
+
+		std::vector<std::thread> Workers;
+		const auto WorkerCount = (std::min)(static_cast<size_t>(JobCount), size(Groups));
+		//!< eWȗт̏̓[J[ŊXbhōs
+		Parallel::WorkerCount = static_cast<uint32_t>(WorkerCount);
+		for (size_t i = 0; i < WorkerCount; ++i) {
+			Workers.emplace_back([&, i]() {
+				Trace::SetThreadName([&]() { return "worker " + std::to_string(i); });
+				for (auto g = Next++; g < size(Groups); g = Next++) {
+					for (auto j : Groups[g]) {
+						auto& J = Jobs[j];
+						Console::OutStream = &J.Out;
+						Console::ErrStream = &J.Err;
+						Invoke(J);
+						Console::OutStream = &std::cout;
+						Console::ErrStream = &std::cerr;
+						{
+							std::lock_guard Lock(Mutex);
+							Done[j] = true;
+						}
+						Condition.notify_all();
+					}
+				}
+			});
+		}
+
+		//!< LqɃR\[֏o
+		for (size_t i = 0; i < size(Jobs); ++i) {
+			{
+				std::unique_lock Lock(Mutex);
+				Condition.wait(Lock, [&]() { return Done[i]; });
+			}
+			std::cout << Jobs[i].Out.str();
+			std::cerr << Jobs[i].Err.str();
+		}
+
+		for (auto& i : Workers) {
+			i.join();
+		}
+	}
+
+	//!< 1 s̍ڂ
+	void ProcessItems(const std::vector<std::string>& Items) {
+		Trace::Scope Span([&]() { return Items[0] + " " + (size(Items) > 1 ? Items[1] : ""); }, "entry");
+		//!< 摜t@C " ͎͂Ŏ菜Ă (Quotes are already removed by ResTokenizer)
+		//const auto FilePath = std::filesystem::absolute(std::filesystem::path(Items[2])).string();
+		const auto& FilePath = Items[2];
+
+		if ("PALETTE" == Items[0]) {
+			ProcessPalette(Items[1], FilePath);
+		}
+		if ("TILESET" == Items[0]) {
+			ProcessTileSet(Items[1], FilePath, size(Items) > 3 ? Items[3] : "", size(Items) > 4 ? Items[4] : "");
+		}
+		if ("ITILESET" == Items[0]) {
+			ProcessImageTileSet(Items[1], FilePath, size(Items) > 3 ? Items[3] : "", size(Items) > 4 ? Items[4] : "");
+		}
+		if ("MAP" == Items[0]) {
+			uint32_t MapBase = 0;
+			if (size(Items) > 5) {
+				auto [ptr, ec] = std::from_chars(data(Items[5]), data(Items[5]) + size(Items[5]), MapBase);
+				if (std::errc() != ec) {}
+			}
+			ProcessMap(Items[1], FilePath, Items[3], size(Items) > 4 ? Items[4] : "", MapBase);
+		}
+		if ("IMAP" == Items[0]) {
+			uint32_t MapBase = 0;
+			if (size(Items) > 5) {
+				auto [ptr, ec] = std::from_chars(data(Items[5]), data(Items[5]) + size(Items[5]), MapBase);
+				if (std::errc() != ec) {}
+			}
+			ProcessImageMap(Items[1], FilePath, Items[3], size(Items) > 4 ? Items[4] : "", MapBase);
+		}
+		if ("SPRITE" == Items[0]) {
+			uint32_t Width = 0;
+			auto [ptr0, ec0] = std::from_chars(data(Items[3]), data(Items[3]) + size(Items[3]), Width);
+			if (std::errc() != ec0) {}
+
+			uint32_t Height = 0;
+			auto [ptr1, ec1] = std::from_chars(data(Items[4]), data(Items[4]) + size(Items[4]), Height);
+			if (std::errc() != ec1) {}
+
+			uint32_t Time = 0;
+			if (size(Items) > 6) {
+				auto [ptr, ec] = std::from_chars(data(Items[6]), data(Items[6]) + size(Items[6]), Time);
+				if (std::errc() != ec) {}
+			}
+
+			uint32_t Iteration = 500000;
+			if (size(Items) > 9) {
+				auto [ptr, ec] = std::from_chars(data(Items[9]), data(Items[9]) + size(Items[9]), Iteration);
+				if (std::errc() != ec) {}
+			}
 
-	std::vector<std::vector<MapEntity>> Map;
-	std::vector<Palette> Palettes;
-	std::vector<Pattern> Patterns;
-};
+			ProcessSprite(Items[1], FilePath, Width, Height, size(Items) > 5 ? Items[5] : "", Time, size(Items) > 7 ? Items[7] : "", size(Items) > 8 ? Items[8] : "", Iteration);
+		}
+	}
 
-class ResourceReaderBase
-{
-public:
-	ResourceReaderBase() {
-		//!< LOG_LEVEL_INFO  gtk ̗]vȃOoĂ̂
-		cv::utils::logging::setLogLevel(cv::utils::logging::LOG_LEVEL_WARNING);
+	//!< Option  REDUCE Εϊ T ̃vbgtH[J[ŌF摜Ԃ
+	//!< REDUCE<F> ŐFw肷Aȗ 1 pbgɎ܂F (\F)
+	template<typename T>
+	static cv::Mat ReduceColor(const cv::Mat& Image, std::string_view Option) {
+		constexpr std::string_view Key = "REDUCE";
+		const auto Pos = Option.find(Key);
+		if (std::string_view::npos == Pos) { return Image; }
+
+		T Conv(Image);
+		uint32_t ColorCount = Conv.GetPaletteColorCount() - Conv.GetPaletteReservedColorCount();
+		const auto Count = Option.substr(Pos + size(Key));
+		auto [ptr, ec] = std::from_chars(data(Count), data(Count) + size(Count), ColorCount);
+		if (std::errc() != ec) {}
+		return Conv.ReduceColor((std::max)(ColorCount, 1u));
+	}
+	//!< s REDUCE w (REDUCE<F>)ATILESET, ITILESET  5 ԖځASPRITE  9 Ԗڂ̍ (΋)
+	static std::string_view GetReduceOption(const std::vector<std::string>& Items) {
+		if (size(Items) < 3) { return {}; }
+		const auto Index = "SPRITE" == Items[0] ? 8 : ("TILESET" == Items[0] || "ITILESET" == Items[0] ? 4 : 0);
+		if (0 == Index || size(Items) <= Index) { return {}; }
+		constexpr std::string_view Key = "REDUCE";
+		const std::string_view Option = Items[Index];
+		const auto Pos = Option.find(Key);
+		if (std::string_view::npos == Pos) { return {}; }
+		const auto Last = (std::min)(Option.find_first_not_of("0123456789", Pos + size(Key)), size(Option));
+		return Option.substr(Pos, Last - Pos);
 	}
 
-	void Read(std::string_view Path) {
-		std::filesystem::current_path(Path);
-		for (const auto& i : std::filesystem::directory_iterator(std::filesystem::current_path())) {
-			if (!i.is_directory()) {
-				//!< .res t@CT (Search for .res files)
-				if (i.path().has_extension() && ".res" == i.path().extension().string()) {
-					std::cout << std::filesystem::absolute(i.path()).string() << std::endl;
-					std::ifstream In(std::filesystem::absolute(i.path()).string(), std::ios::in);
-					if (!In.fail()) {
-						//!< sǂݍ (Read line)
-						std::string Line;
-						while (std::getline(In, Line)) {
-							//!< ڂǂݍ (Read items)
-							std::vector<std::string> Items;
-							std::stringstream SS(Line);
-							std::string Item;
-							while (std::getline(SS, Item, ' ')) {
-								Items.emplace_back(Item);
-							}
+	//!< F (ReduceColor<T>)
+	using ReduceFunc = cv::Mat(*)(const cv::Mat&, std::string_view);
+	//!< 摜ɓKp錸F (̉摜 REDUCE w肵Gg̎ނƎw)
+	struct Reduction
+	{
+		std::string Type;
+		std::string Option;
+		ReduceFunc Func = nullptr;
+		//!< ImageCache::Reduce() ƃ}jtFXg̃L[
+		std::string GetKey() const { return Type + " " + Option; }
+	};
+	std::unordered_map<std::string, Reduction> Reductions; //!< REDUCE w肵摜 (KpXARead() ŏW߂)
+	//!< Gg̎ (TILESET, ITILESET, SPRITE) ̕ϊŌF֐ (FłȂ nullptr)
+	virtual ReduceFunc GetReduceFunc([[maybe_unused]] std::string_view Type) const { return nullptr; }
+	//!< 摜ǂݍށAREDUCE w肵摜Ȃ猸F̂Ԃ
+	//!< F͉摜Ǝw薈 1 񂾂sẢ摜QƂSẴGg (PALETTE, MAP ܂) œ cv::Mat g
+	cv::Mat ReadImage(std::string_view File) const {
+		const auto Image = ImageCache::Instance().Read(File);
+		const auto It = Reductions.find(std::filesystem::path(File).lexically_normal().string());
+		if (end(Reductions) == It) { return Image; }
+		const auto& Red = It->second;
+		return ImageCache::Instance().Reduce(Image, Red.GetKey(), [&]() { return Red.Func(Image, Red.Option); });
+	}
 
-							if (!empty(Items)) {
-								//!< 摜t@C " 菜 (Remove " from image file name)
-								std::erase(Items[2], '"');
-								//const auto FilePath = std::filesystem::absolute(std::filesystem::path(Items[2])).string();
-								const auto FilePath = Items[2];
-
-								if ("PALETTE" == Items[0]) {
-									ProcessPalette(Items[1], FilePath);
-								}
-								if ("TILESET" == Items[0]) {
-									ProcessTileSet(Items[1], FilePath, size(Items) > 3 ? Items[3] : "", size(Items) > 4 ? Items[4] : "");
-								}
-								if ("ITILESET" == Items[0]) {
-									ProcessImageTileSet(Items[1], FilePath, size(Items) > 3 ? Items[3] : "", size(Items) > 4 ? Items[4] : "");
-								}
-								if ("MAP" == Items[0]) {
-									uint32_t MapBase = 0;
-									if (size(Items) > 5) {
-										auto [ptr, ec] = std::from_chars(data(Items[5]), data(Items[5]) + size(Items[5]), MapBase);
-										if (std::errc() != ec) {}
-									}
-									ProcessMap(Items[1], FilePath, Items[3], size(Items) > 4 ? Items[4] : "", MapBase);
-								}
-								if ("IMAP" == Items[0]) {
-									uint32_t MapBase = 0;
-									if (size(Items) > 5) {
-										auto [ptr, ec] = std::from_chars(data(Items[5]), data(Items[5]) + size(Items[5]), MapBase);
-										if (std::errc() != ec) {}
-									}
-									ProcessImageMap(Items[1], FilePath, Items[3], size(Items) > 4 ? Items[4] : "", MapBase);
-								}
-								if ("SPRITE" == Items[0]) {
-									uint32_t Width = 0;
-									auto [ptr0, ec0] = std::from_chars(data(Items[3]), data(Items[3]) + size(Items[3]), Width);
-									if (std::errc() != ec0) {}
-
-									uint32_t Height = 0;
-									auto [ptr1, ec1] = std::from_chars(data(Items[4]), data(Items[4]) + size(Items[4]), Height);
-									if (std::errc() != ec1) {}
-
-									uint32_t Time = 0;
-									if (size(Items) > 6) {
-										auto [ptr, ec] = std::from_chars(data(Items[6]), data(Items[6]) + size(Items[6]), Time);
-										if (std::errc() != ec) {}
-									}
-
-									uint32_t Iteration = 500000;
-									if (size(Items) > 9) {
-										auto [ptr, ec] = std::from_chars(data(Items[9]), data(Items[9]) + size(Items[9]), Iteration);
-										if (std::errc() != ec) {}
-									}
-
-									ProcessSprite(Items[1], FilePath, Width, Height, size(Items) > 5 ? Items[5] : "", Time, size(Items) > 7 ? Items[7] : "", size(Items) > 8 ? Items[8] : "", Iteration);
-								}
-							}
-						}
-						In.close();
-					}
+	//!< XvCg̃TCY (sNZ) ɓꉻϊ֐
+	struct SpriteKernel
+	{
+		uint32_t Width;
+		uint32_t Height;
+		void (*Convert)(const cv::Mat& Image, std::string_view Name);
+	};
+	//!< T::SpriteSizes ɕׂSẴTCYɂ T::ConvertSprite<W, H> ̃e[u (TCY𑝂₷ɂ SpriteSizes ֑ł悢)
+	template<typename T, size_t... I>
+	static constexpr auto CreateSpriteKernels(std::index_sequence<I...>) {
+		return std::array<SpriteKernel, sizeof...(I)>({ SpriteKernel({ T::SpriteSizes[I].first, T::SpriteSizes[I].second, &T::template ConvertSprite<T::SpriteSizes[I].first, T::SpriteSizes[I].second> })... });
+	}
+	template<typename T>
+	static constexpr auto CreateSpriteKernels() { return CreateSpriteKernels<T>(std::make_index_sequence<size(T::SpriteSizes)>()); }
+	//!< Width x Height (sNZ) ̕ϊ֐ŏAe[uɖTCY̓T|[gĂTCYăG[Ƃ
+	template<size_t N>
+	static void ProcessSpriteKernel(const std::array<SpriteKernel, N>& Kernels, const cv::Mat& Image, std::string_view Name, const uint32_t Width, const uint32_t Height) {
+		if (const auto It = std::ranges::find_if(Kernels, [&](const SpriteKernel& rhs) { return rhs.Width == Width && rhs.Height == Height; }); end(Kernels) != It) {
+			It->Convert(Image, Name);
+			return;
+		}
+		Console::Err() << "Sprite size not supported (" << Width << " x " << Height << ", supported :";
+		for (const auto& i : Kernels) {
+			Console::Err() << " " << i.Width << "x" << i.Height;
+		}
+		Console::Err() << ")" << std::endl;
+	}
+
+	//!< ؂ MAP, IMAP Gg
+	struct VerifyEntry
+	{
+		std::string Type;
+		std::string Name;
+		std::string File;
+		std::string TileSet;
+		std::string Palette; //!< 摜QƂĂ PALETTE Gg̏o͖ (΋)
+	};
+	enum class VERIFY {
+		PASS,
+		FAIL,
+		SKIP,
+	};
+	static VERIFY VerifyFail(std::string_view Reason) { Console::Err() << "\t" << Reason << std::endl; return VERIFY::FAIL; }
+	static VERIFY VerifySkip(std::string_view Reason) { Console::Out() << "\tSkipped : " << Reason << std::endl; return VERIFY::SKIP; }
+	//!< Name.bin  T ̔zƂēǂݍ
+	template<typename T>
+	static bool ReadBin(const std::string& Name, std::vector<T>& Dst) {
+		const MappedFile File(Name + ".bin");
+		const auto View = File.GetView();
+		if (empty(View) || 0 != size(View) % sizeof(T)) { return false; }
+		Dst.resize(size(View) / sizeof(T));
+		std::memcpy(data(Dst), data(View), size(View));
+		return true;
+	}
+	//!< 摜 (vbgtH[J[ASize ̑傫) 摜̍Ɣr
+	//!< Traits ͊evbgtH[̖OԂŒ`ŗL̒l (RpCɌ܂̂ŁA[vł͉z֐ɂg)
+	//!< sv͌摜ʎq (vbgtH[J[֕ϊ) ̂ƃsNZɔrĐAPSNR ͌摜ɑ΂ċ߂
+	template<typename Traits>
+	static VERIFY Compare(const cv::Mat& Image, const cv::Size& Size, const std::vector<uint16_t>& Plane) {
+		uint64_t Mismatches = 0;
+		double SquaredError = 0.0;
+		for (auto i = 0; i < Size.height; ++i) {
+			const auto Src = Image.ptr<cv::Vec3b>(i);
+			const auto Dst = &Plane[static_cast<size_t>(i) * Size.width];
+			for (auto j = 0; j < Size.width; ++j) {
+				if (Traits::ToPlatformColor(Src[j]) != Dst[j]) { ++Mismatches; }
+				const auto Color = Traits::FromPlatformColor(Dst[j]);
+				for (auto c = 0; c < 3; ++c) {
+					const auto Diff = static_cast<double>(Color[c]) - static_cast<double>(Src[j][c]);
+					SquaredError += Diff * Diff;
 				}
 			}
 		}
+		const auto Count = static_cast<uint64_t>(Size.area());
+		const auto MSE = SquaredError / (static_cast<double>(Count) * 3.0);
+		std::ostringstream PSNR;
+		if (0.0 == MSE) {
+			PSNR << "inf";
+		}
+		else {
+			PSNR << std::fixed << std::setprecision(2) << 10.0 * std::log10(255.0 * 255.0 / MSE) << " dB";
+		}
+		Console::Out() << "\tMismatches = " << Mismatches << " / " << Count << ", PSNR = " << PSNR.str() << std::endl;
+		return 0 == Mismatches ? VERIFY::PASS : VERIFY::FAIL;
 	}
+
+public:
 	virtual void ProcessPalette(std::string_view Name, std::string_view File) {}
 	virtual void ProcessTileSet(std::string_view Name, std::string_view File, [[maybe_unused]] std::string_view Compression, [[maybe_unused]] std::string_view Option) {}
 	virtual void ProcessImageTileSet(std::string_view Name, std::string_view File, [[maybe_unused]] std::string_view Compression, [[maybe_unused]] std::string_view Option) {}
@@ -609,6 +2881,9 @@ public:
 	virtual void ProcessImageMap(std::string_view Name, std::string_view File, std::string_view TileSet, [[maybe_unused]] std::string_view Compression, [[maybe_unused]] const uint32_t Mapbase) {}
 	virtual void ProcessSprite(std::string_view Name, std::string_view File, const uint32_t Width, const uint32_t Height, [[maybe_unused]] std::string_view Compression, [[maybe_unused]] const uint32_t Time, [[maybe_unused]] std::string_view Collision, [[maybe_unused]] std::string_view Option, [[maybe_unused]] const uint32_t Iteration) {}
 
+	//!< o͂ .bin }bv̉摜𕜌Č摜Ɣr (vbgtH[̌`ŕ)
+	virtual VERIFY VerifyMap([[maybe_unused]] const VerifyEntry& Ent) const { return VerifySkip("Not supported on this platform"); }
+
 	virtual void Clear(std::string_view Name) {
 		std::filesystem::remove(std::string(Name) + ".bin");
 		std::filesystem::remove(std::string(Name) + ".text");
@@ -616,7 +2891,10 @@ public:
 	virtual void ClearPalette(std::string_view Name) { Clear(Name); }
 	virtual void ClearTileSet(std::string_view Name) { Clear(Name); }
 	virtual void ClearMap(std::string_view Name) { Clear(Name); }
-	virtual void ClearSprite(std::string_view Name) { Clear(Name); }
+	virtual void ClearSprite(std::string_view Name) {
+		Clear(Name);
+		Clear(std::string(Name) + ".anim");
+	}
 
 };
 
@@ -628,6 +2906,19 @@ public:
 */
 namespace PCE
 {
+	//!< F 9 rbgJ[̂܂܎g
+	struct Traits
+	{
+		static constexpr std::string_view Name = "PCE";
+		static constexpr uint32_t ColorCount = 1 << 9; //!< 9 rbgJ[
+		static constexpr uint16_t PaletteCount = 16;
+		static constexpr uint16_t PaletteColorCount = 16;
+		static constexpr uint16_t PaletteReservedColorCount = 1; //!< 擪͓F (wiF)
+
+		static uint16_t ToPlatformColor(const cv::Vec3b& Color) { return ((Color[1] >> 5) << 6) | ((Color[2] >> 5) << 3) | (Color[0] >> 5); }
+		static cv::Vec3b FromPlatformColor(const uint16_t Color) { return cv::Vec3b((Color & 0x7) << 5, ((Color & (0x7 << 6)) >> 6) << 5, ((Color & (0x7 << 3)) >> 3) << 5); }
+	};
+
 	template<uint8_t W, uint8_t H>
 	class ConverterBase : public Converter<W, H>
 	{
@@ -636,25 +2927,89 @@ namespace PCE
 	public:
 		ConverterBase(const cv::Mat& Img) : Super(Img) {}
 
-		virtual uint16_t ToPlatformColor(const cv::Vec3b& Color) const override { return ((Color[1] >> 5) << 6) | ((Color[2] >> 5) << 3) | (Color[0] >> 5); }
-		virtual cv::Vec3b FromPlatformColor(const uint16_t& Color) const override { return cv::Vec3b((Color & 0x7) << 5, ((Color & (0x7 << 6)) >> 6) << 5, ((Color & (0x7 << 3)) >> 3) << 5); }
+		virtual std::string_view GetPlatformName() const override final { return Traits::Name; }
+
+		virtual uint16_t ToPlatformColor(const cv::Vec3b& Color) const override final { return Traits::ToPlatformColor(Color); }
+		//!< GGGRRRBBB  9 rbg֋l߂A16 sNZ SIMD ŏ
+		virtual void ToPlatformColorPlane(std::vector<uint16_t>& Plane, const cv::Mat& Img) const override {
+			Plane.resize(Img.total());
+#ifdef USE_SSSE3
+			//!< BGR ̕тe`l 16 oCg֏W߂Vbt (\[X 16 oCgubN 3 )
+			static const auto Shuffles = []() {
+				std::array<std::array<std::array<int8_t, 16>, 3>, 3> Masks;
+				for (auto c = 0; c < 3; ++c) {
+					for (auto b = 0; b < 3; ++b) {
+						for (auto k = 0; k < 16; ++k) {
+							const auto Src = k * 3 + c - b * 16;
+							Masks[c][b][k] = (0 <= Src && Src < 16) ? static_cast<int8_t>(Src) : static_cast<int8_t>(0x80);
+						}
+					}
+				}
+				return Masks;
+			}();
+			const auto Gather = [&](const __m128i (&Src)[3], const int c) {
+				auto Dst = _mm_setzero_si128();
+				for (auto b = 0; b < 3; ++b) {
+					Dst = _mm_or_si128(Dst, _mm_shuffle_epi8(Src[b], _mm_loadu_si128(reinterpret_cast<const __m128i*>(data(Shuffles[c][b])))));
+				}
+				//!<  3 rbg
+				return _mm_and_si128(_mm_srli_epi16(Dst, 5), _mm_set1_epi8(0x07));
+			};
+#endif
+			for (auto i = 0; i < Img.rows; ++i) {
+				const auto Src = Img.ptr<cv::Vec3b>(i);
+				const auto Dst = &Plane[i * Img.cols];
+				auto j = 0;
+#ifdef USE_SSSE3
+				for (; j + 16 <= Img.cols; j += 16) {
+					const auto Ptr = reinterpret_cast<const __m128i*>(&Src[j]);
+					const __m128i Pixels[] = { _mm_loadu_si128(Ptr + 0), _mm_loadu_si128(Ptr + 1), _mm_loadu_si128(Ptr + 2) };
+					//!<  6 rbg (RRRBBB) ̓oCĝ܂܁AG  16 rbg֍LĂ 6 rbgVtg
+					const auto RB = _mm_or_si128(Gather(Pixels, 0), _mm_slli_epi16(Gather(Pixels, 2), 3));
+					const auto G = Gather(Pixels, 1);
+					const auto Zero = _mm_setzero_si128();
+					const auto Lo = _mm_or_si128(_mm_unpacklo_epi8(RB, Zero), _mm_slli_epi16(_mm_unpacklo_epi8(G, Zero), 6));
+					const auto Hi = _mm_or_si128(_mm_unpackhi_epi8(RB, Zero), _mm_slli_epi16(_mm_unpackhi_epi8(G, Zero), 6));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(&Dst[j + 0]), Lo);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(&Dst[j + 8]), Hi);
+				}
+#endif
+				for (; j < Img.cols; ++j) {
+					Dst[j] = Traits::ToPlatformColor(Src[j]);
+				}
+			}
+		}
+		virtual cv::Vec3b FromPlatformColor(const uint16_t& Color) const override final { return Traits::FromPlatformColor(Color); }
+		virtual uint32_t GetPlatformColorCount() const override final { return Traits::ColorCount; }
 
-		virtual uint16_t GetPaletteCount() const override { return 16; };
-		virtual uint16_t GetPaletteColorCount() const override { return 16; }
+		virtual uint16_t GetPaletteCount() const override final { return Traits::PaletteCount; };
+		virtual uint16_t GetPaletteColorCount() const override final { return Traits::PaletteColorCount; }
+		virtual bool HasPaletteReservedColor() const override final { return 0 < Traits::PaletteReservedColorCount; }
+		virtual uint16_t GetPaletteReservedColorCount() const override final { return Traits::PaletteReservedColorCount; }
 
 		virtual const ConverterBase& OutputPalette(std::string_view Name) const override {
+			Trace::Scope Span("OutputPalette");
 			this->OutputPaletteOfType<uint16_t>(Name);
 			return *this;
 		}
+		//!< p^[ (x, y)  8 x 8 A2 v[ u16 ̏ʉ 8 rbg֋l߂
+		void EncodeTile8x8(std::vector<uint16_t>& Words, const typename Super::Pattern& Pat, const uint32_t x, const uint32_t y) const {
+			std::array<std::array<uint16_t, 4>, 8> Rows;
+			for (auto i = 0; i < 8; ++i) {
+				Rows[i] = BitPlane::Gather<8>(&Pat.ColorIndices[y + i][x], Traits::PaletteReservedColorCount); //!< 擪̓Fl
+			}
+			for (auto pl = 0; pl < 2; ++pl) {
+				for (auto i = 0; i < 8; ++i) {
+					Words.emplace_back(Rows[i][(pl << 1) + 0] | (Rows[i][(pl << 1) + 1] << 8));
+				}
+			}
+		}
 		virtual uint8_t PaletteIndexShift() const { return 0; };
 		virtual const ConverterBase& OutputPatternPalette(std::string_view Name) const {
-			std::ofstream OutBin(data(std::string(Name) + ".pal" + ".bin"), std::ios::binary | std::ios::out);
-			assert(!OutBin.bad());
-			std::ofstream OutText(data(std::string(Name) + ".pal" + ".txt"), std::ios::out);
-			assert(!OutText.bad());
+			Trace::Scope Span("OutputPatternPalette");
+			OutputBuffer Out(std::string(Name) + ".pal");
 
-			//OutText << "const " << typeid(uint8_t).name() << " " << Name << "_PAL[] = {" << std::endl;
-			OutText << "const u" << (sizeof(uint8_t) << 3) << " " << Name << "_PAL[] = {" << std::endl;
+			Out.Header<uint8_t>(std::string(Name) + "_PAL");
 
 			for (auto i = 0; i < size(this->Patterns); ++i) {
 				const auto& Pat = this->Patterns[i];
@@ -663,16 +3018,16 @@ namespace PCE
 				assert(Pat.HasValidPaletteIndex());
 				const uint8_t PalIdx = Pat.PaletteIndex << PaletteIndexShift();
 
-				OutText << "\t0x" << std::hex << std::setw(sizeof(PalIdx) << 1) << std::right << std::setfill('0') << static_cast<uint16_t>(PalIdx);
-				if (size(this->Patterns) - 1 > i) { OutText << ", "; }
-				OutText << std::endl;
+				Out << "\t";
+				Out.Hex(PalIdx);
+				if (size(this->Patterns) - 1 > i) { Out << ", "; }
+				Out << "\n";
 
-				OutBin.write(reinterpret_cast<const char*>(&PalIdx), sizeof(PalIdx));
+				Out.Write(PalIdx);
 			}
-			OutText << "};" << std::endl;
+			Out.Footer();
 
-			OutBin.close();
-			OutText.close();
+			Out.Close();
 
 			return *this;
 		}
@@ -705,78 +3060,49 @@ namespace PCE
 			virtual Converter& Create() override { Super::Create(); return *this; }
 
 			virtual const Converter& OutputPattern(std::string_view Name) const override {
-				std::cout << "\tPattern count = " << size(this->Patterns) << std::endl;
-
-				std::ofstream OutBin(data(std::string(Name) + ".bin"), std::ios::binary | std::ios::out);
-				assert(!OutBin.bad());
-				std::ofstream OutText(data(std::string(Name) + ".txt"), std::ios::out);
-				assert(!OutText.bad());
+				Trace::Scope Span("OutputPattern");
+				Console::Out() << "\tPattern count = " << size(this->Patterns) << std::endl;
 
-				//OutText << "const " << typeid(uint16_t).name() << " " << Name << "[] = {" << std::endl;
-				OutText << "const u" << (sizeof(uint16_t) << 3) << " " << Name << "[] = {" << std::endl;
-
-				for (auto pat = 0; pat < size(this->Patterns); ++pat) {
-					const auto& Pat = this->Patterns[pat];
-					//!< 2 v[
-					for (auto pl = 0; pl < 2; ++pl) {
-						OutText << "\t";
-						for (auto i = 0; i < size(Pat.ColorIndices); ++i) {
-							uint16_t Plane = 0;
-							for (auto j = 0; j < size(Pat.ColorIndices[i]); ++j) {
-								const auto ColorIndex = Pat.ColorIndices[i][j] + this->GetPaletteReservedColorCount(); //!< 擪̓Fl
-								const auto ShiftL = 7 - j;
-								const auto ShiftU = ShiftL + 8;
-								const auto MaskL = 1 << ((pl << 1) + 0);
-								const auto MaskU = 1 << ((pl << 1) + 1);
-								Plane |= ((ColorIndex & MaskL) ? 1 : 0) << ShiftL;
-								Plane |= ((ColorIndex & MaskU) ? 1 : 0) << ShiftU;
-							}
-							OutText << "0x" << std::hex << std::setw(sizeof(Plane) << 1) << std::right << std::setfill('0') << Plane;
-							if (size(this->Patterns) - 1 > pat || 1 > pl || size(Pat.ColorIndices) - 1 > i) { OutText << ", "; }
-
-							OutBin.write(reinterpret_cast<const char*>(&Plane), sizeof(Plane));
-						}
-					}
-					OutText << std::endl;
+				std::vector<uint16_t> Words;
+				Words.reserve(size(this->Patterns) * 16);
+				for (const auto& Pat : this->Patterns) {
+					this->EncodeTile8x8(Words, Pat, 0, 0);
 				}
-				OutText << "};" << std::endl;
-
-				OutBin.close();
-				OutText.close();
+				//!< 2 v[ŉs
+				this->OutputPatternOfType(Name, Words, H, 2);
 
 				return *this;
 			}
 			//!< BAT ̓p^[ԍƃpbgԍȂ}bv
 			virtual const Converter& OutputBAT(std::string_view Name) const override {
-				std::cout << "\tBAT size = " << size(this->Map[0]) << " x " << size(this->Map) << std::endl;
+				Trace::Scope Span("OutputBAT");
+				Console::Out() << "\tBAT size = " << this->Map.GetWidth() << " x " << this->Map.GetHeight() << std::endl;
 
-				std::ofstream OutBin(data(std::string(Name) + ".bin"), std::ios::binary | std::ios::out);
-				assert(!OutBin.bad());
-				std::ofstream OutText(data(std::string(Name) + ".txt"), std::ios::out);
-				assert(!OutText.bad());
+				OutputBuffer Out(Name);
+				Out.Reserve(this->Map.GetHeight() * this->Map.GetWidth() * 9, this->Map.GetHeight() * this->Map.GetWidth() * sizeof(uint16_t));
 
-				//OutText << "const " << typeid(uint16_t).name() << " " << Name << "[] = {" << std::endl;
-				OutText << "const u" << (sizeof(uint16_t) << 3) << " " << Name << "[] = {" << std::endl;
+				Out.Header<uint16_t>(Name);
 
-				for (auto i = 0; i < size(this->Map); ++i) {
-					OutText << "\t";
-					for (auto j = 0; j < size(this->Map[i]); ++j) {
-						const auto PatIdx = this->Map[i][j].PatternIndex;
+				for (auto i = 0; i < this->Map.GetHeight(); ++i) {
+					Out << "\t";
+					for (auto j = 0; j < this->Map.GetWidth(); ++j) {
+						const auto PatIdx = this->Map(i, j).PatternIndex;
 						assert(this->Patterns[PatIdx].HasValidPaletteIndex());
+						//!< BAT ͔]ĂȂ
+						assert(0 == this->Map(i, j).Flags);
 
 						//!< Avgpłp^[CfbNX 256 ȍ~ [256, 4095] Ȃ̂ŃItZbg
 						const uint16_t BAT = (this->Patterns[PatIdx].PaletteIndex << 12) | (PatIdx + 256);
-						OutBin.write(reinterpret_cast<const char*>(&BAT), sizeof(BAT));
+						Out.Write(BAT);
 
-						OutText << "0x" << std::hex << std::setw(sizeof(BAT) << 1) << std::right << std::setfill('0') << BAT;
-						if (size(this->Map) - 1 > i || size(this->Map[i]) - 1 > j) { OutText << ", "; }
+						Out.Hex(BAT);
+						if (this->Map.GetHeight() - 1 > i || this->Map.GetWidth() - 1 > j) { Out << ", "; }
 					}
-					OutText << std::endl;
+					Out << "\n";
 				}
-				OutText << "};" << std::endl;
+				Out.Footer();
 
-				OutBin.close();
-				OutText.close();
+				Out.Close();
 
 				return *this;
 			}
@@ -812,114 +3138,21 @@ namespace PCE
 			virtual Converter& Create() override { Super::Create(); return *this; }
 
 			virtual const Converter& OutputPattern(std::string_view Name) const override {
-				std::cout << "\tPattern count = " << size(this->Patterns) << std::endl;
-
-				std::ofstream OutBin(data(std::string(Name) + ".bin"), std::ios::binary | std::ios::out);
-				assert(!OutBin.bad());
-				std::ofstream OutText(data(std::string(Name) + ".txt"), std::ios::out);
-				assert(!OutText.bad());
-
-				//OutText << "const " << typeid(uint16_t).name() << " " << Name << "[] = {" << std::endl;
-				OutText << "const u" << (sizeof(uint16_t) << 3) << " " << Name << "[] = {" << std::endl;
+				Trace::Scope Span("OutputPattern");
+				Console::Out() << "\tPattern count = " << size(this->Patterns) << std::endl;
 
 				//!< 16 x 16 ̃p^[ 4  8 x 8  (LT, RT, LB, RB) ɕďo͂
-				for (auto pat = 0; pat < size(this->Patterns); ++pat) {
-					const auto& Pat = this->Patterns[pat];
-
-					const auto h = size(Pat.ColorIndices) >> 1;
-					const auto w = size(Pat.ColorIndices[0]) >> 1;
-
-					//!< LT ( 8 x 8)
-					//!< 2 v[
-					for (auto pl = 0; pl < 2; ++pl) {
-						OutText << "\t";
-						//!< 8 x 8 
-						for (auto i = 0; i < h; ++i) {
-							uint16_t Plane = 0;
-							for (auto j = 0; j < w; ++j) {
-								const auto ColorIndex = Pat.ColorIndices[i][j] + this->GetPaletteReservedColorCount(); //!< 擪̓Fl
-								const auto ShiftL = 7 - j;
-								const auto ShiftU = ShiftL + 8;
-								const auto MaskL = 1 << ((pl << 1) + 0);
-								const auto MaskU = 1 << ((pl << 1) + 1);
-								Plane |= ((ColorIndex & MaskL) ? 1 : 0) << ShiftL;
-								Plane |= ((ColorIndex & MaskU) ? 1 : 0) << ShiftU;
-							}
-							OutText << "0x" << std::hex << std::setw(sizeof(Plane) << 1) << std::right << std::setfill('0') << Plane << ", ";
-
-							OutBin.write(reinterpret_cast<const char*>(&Plane), sizeof(Plane));
-						}
-					}
-					OutText << std::endl;
-
-					//!< RT (E 8 x 8)
-					for (auto pl = 0; pl < 2; ++pl) {
-						OutText << "\t";
-						for (auto i = 0; i < h; ++i) {
-							uint16_t Plane = 0;
-							for (auto j = 0; j < w; ++j) {
-								const auto ColorIndex = Pat.ColorIndices[i][j + w] + this->GetPaletteReservedColorCount();
-								const auto ShiftL = 7 - j;
-								const auto ShiftU = ShiftL + 8;
-								const auto MaskL = 1 << ((pl << 1) + 0);
-								const auto MaskU = 1 << ((pl << 1) + 1);
-								Plane |= ((ColorIndex & MaskL) ? 1 : 0) << ShiftL;
-								Plane |= ((ColorIndex & MaskU) ? 1 : 0) << ShiftU;
-							}
-							OutText << "0x" << std::hex << std::setw(sizeof(Plane) << 1) << std::right << std::setfill('0') << Plane << ", ";
-
-							OutBin.write(reinterpret_cast<const char*>(&Plane), sizeof(Plane));
-						}
-					}
-					OutText << std::endl;
-
-					//!< LB ( 8 x 8)
-					for (auto pl = 0; pl < 2; ++pl) {
-						OutText << "\t";
-						for (auto i = 0; i < h; ++i) {
-							uint16_t Plane = 0;
-							for (auto j = 0; j < w; ++j) {
-								const auto ColorIndex = Pat.ColorIndices[i + h][j] + this->GetPaletteReservedColorCount();
-								const auto ShiftL = 7 - j;
-								const auto ShiftU = ShiftL + 8;
-								const auto MaskL = 1 << ((pl << 1) + 0);
-								const auto MaskU = 1 << ((pl << 1) + 1);
-								Plane |= ((ColorIndex & MaskL) ? 1 : 0) << ShiftL;
-								Plane |= ((ColorIndex & MaskU) ? 1 : 0) << ShiftU;
-							}
-							OutText << "0x" << std::hex << std::setw(sizeof(Plane) << 1) << std::right << std::setfill('0') << Plane << ", ";
-
-							OutBin.write(reinterpret_cast<const char*>(&Plane), sizeof(Plane));
-						}
-					}
-					OutText << std::endl;
-
-					//!< RB (E 8 x 8)
-					for (auto pl = 0; pl < 2; ++pl) {
-						OutText << "\t";
-						for (auto i = 0; i < h; ++i) {
-							uint16_t Plane = 0;
-							for (auto j = 0; j < w; ++j) {
-								const auto ColorIndex = Pat.ColorIndices[i + h][j + w] + this->GetPaletteReservedColorCount();
-								const auto ShiftL = 7 - j;
-								const auto ShiftU = ShiftL + 8;
-								const auto MaskL = 1 << ((pl << 1) + 0);
-								const auto MaskU = 1 << ((pl << 1) + 1);
-								Plane |= ((ColorIndex & MaskL) ? 1 : 0) << ShiftL;
-								Plane |= ((ColorIndex & MaskU) ? 1 : 0) << ShiftU;
-							}
-							OutText << "0x" << std::hex << std::setw(sizeof(Plane) << 1) << std::right << std::setfill('0') << Plane;
-							if (size(this->Patterns) - 1 > pat || 1 > pl || h - 1 > i) { OutText << ", "; }
-
-							OutBin.write(reinterpret_cast<const char*>(&Plane), sizeof(Plane));
-						}
-					}
-					OutText << std::endl;
+				constexpr auto w = W >> 1, h = H >> 1;
+				std::vector<uint16_t> Words;
+				Words.reserve(size(this->Patterns) * 64);
+				for (const auto& Pat : this->Patterns) {
+					this->EncodeTile8x8(Words, Pat, 0, 0); //!< LT ( 8 x 8)
+					this->EncodeTile8x8(Words, Pat, w, 0); //!< RT (E 8 x 8)
+					this->EncodeTile8x8(Words, Pat, 0, h); //!< LB ( 8 x 8)
+					this->EncodeTile8x8(Words, Pat, w, h); //!< RB (E 8 x 8)
 				}
-				OutText << "};" << std::endl;
-
-				OutBin.close();
-				OutText.close();
+				//!< 8 x 8  (2 v[) ɉs
+				this->OutputPatternOfType(Name, Words, h, 2);
 
 				return *this;
 			}
@@ -938,51 +3171,35 @@ namespace PCE
 		public:
 			Converter(const cv::Mat& Img) : Super(Img) {}
 
+			//!< XvCg͔]\\ (SATB ̑)
+			virtual bool IsFlipSupported() const override { return true; }
+
 			virtual Converter& Create() override { Super::Create(); return *this; }
 
 			//virtual Converter& CreatePalette() { this->CreatePalettePerMapRow(); return *this; }
 
 			virtual const Converter& OutputPattern(std::string_view Name) const override {
-				std::cout << "\tPattern count = " << size(this->Patterns) << std::endl;
-				std::cout << "\tSprite size = " << static_cast<uint16_t>(W) << " x " << static_cast<uint16_t>(H) << std::endl;
+				Trace::Scope Span("OutputPattern");
+				Console::Out() << "\tPattern count = " << size(this->Patterns) << std::endl;
+				Console::Out() << "\tSprite size = " << static_cast<uint16_t>(W) << " x " << static_cast<uint16_t>(H) << std::endl;
 
-				std::ofstream OutBin(data(std::string(Name) + ".bin"), std::ios::binary | std::ios::out);
-				assert(!OutBin.bad());
-				std::ofstream OutText(data(std::string(Name) + ".txt"), std::ios::out);
-				assert(!OutText.bad());
-
-				//OutText << "const " << typeid(uint16_t).name() << " " << Name << "[] = {" << std::endl;
-				OutText << "const u" << (sizeof(uint16_t) << 3) << " " << Name << "[] = {" << std::endl;
-
-				for (auto pat = 0; pat < size(this->Patterns); ++pat) {
-					const auto& Pat = this->Patterns[pat];
+				std::vector<uint16_t> Words;
+				Words.reserve(size(this->Patterns) * 4 * H);
+				for (const auto& Pat : this->Patterns) {
 					//!< p^[̃pbgCfbNXo
 					assert(Pat.HasValidPaletteIndex());
-					std::cout << "\t\tPalette index = " << Pat.PaletteIndex << std::endl;
+					Console::Out() << "\t\tPalette index = " << Pat.PaletteIndex << std::endl;
 
-					//!< 4 v[
+					//!< 4 v[Aes 16 sNZ u16 ֋l߂ ( 32 ̏ꍇ]ʂ擪 16 sNẐ)
+					const auto Rows = BitPlane::Gather<16>(Pat.ColorIndices, 0, Traits::PaletteReservedColorCount); //!< 擪̓Fl
 					for (auto pl = 0; pl < 4; ++pl) {
-						OutText << "\t";
-						for (auto i = 0; i < size(Pat.ColorIndices); ++i) {
-							uint16_t Plane = 0;
-							for (auto j = 0; j < size(Pat.ColorIndices[i]); ++j) {
-								const auto ColorIndex = Pat.ColorIndices[i][j] + this->GetPaletteReservedColorCount(); //!< 擪̓Fl
-								const auto Shift = 15 - j;
-								const auto Mask = 1 << pl;
-								Plane |= ((ColorIndex & Mask) ? 1 : 0) << Shift;
-							}
-							OutText << "0x" << std::hex << std::setw(sizeof(Plane) << 1) << std::right << std::setfill('0') << Plane;
-							if (size(this->Patterns) - 1 > pat || 3 > pl || size(Pat.ColorIndices) - 1 > i) { OutText << ", "; }
-
-							OutBin.write(reinterpret_cast<const char*>(&Plane), sizeof(Plane));
+						for (auto i = 0; i < H; ++i) {
+							Words.emplace_back(Rows[i][pl]);
 						}
 					}
-					OutText << std::endl;
 				}
-				OutText << "};" << std::endl;
-
-				OutBin.close();
-				OutText.close();
+				//!< 4 v[ŉs
+				this->OutputPatternOfType(Name, Words, H, 4);
 
 				return *this;
 			}
@@ -994,90 +3211,134 @@ namespace PCE
 	private:
 		using Super = ResourceReaderBase;
 	public:
+		virtual std::string_view GetPlatformName() const override { return "PCE"; }
+		virtual ReduceFunc GetReduceFunc(std::string_view Type) const override {
+			if ("TILESET" == Type) { return &ReduceColor<BG::Converter<>>; }
+			if ("ITILESET" == Type) { return &ReduceColor<Image::Converter<>>; }
+			if ("SPRITE" == Type) { return &ReduceColor<Sprite::Converter<16, 16>>; }
+			return nullptr;
+		}
+
 		virtual void ProcessPalette(std::string_view Name, std::string_view File) override {
 			if (!empty(File)) {
-				auto Image = cv::imread(data(File));
-				std::cout << "[ Output Palette ] " << Name << " (" << File << ")" << std::endl;
-#if 0
-				Image::Converter<>(Image).Create().OutputPalette(Name).RestorePalette();
-#else
-				BG::Converter<>(Image).Create().OutputPalette(Name).RestorePalette();
-#endif
+				const auto Image = ReadImage(File);
+				Console::Out() << "[ Output Palette ] " << Name << " (" << File << ")" << std::endl;
+				if constexpr (IsImagePalette) {
+					Converted.Get<Image::Converter<>>(Image, File)->OutputPalette(Name).RestorePalette();
+				}
+				else {
+					Converted.Get<BG::Converter<>>(Image, File)->OutputPalette(Name).RestorePalette();
+				}
 			}
 		}
+		//!< PALETTE C[W (IMAP) ̕ϊō邩 (false Ȃ BG (MAP) ̕ϊ)
+		//!< pbg̕т͕ϊ했ɈقȂ̂ŁA؂ł͓̂ϊ̃Gĝ
+		static constexpr bool IsImagePalette = false;
 		virtual void ProcessTileSet(std::string_view Name, std::string_view File, [[maybe_unused]] std::string_view Compression, [[maybe_unused]] std::string_view Option) override {
 			if (!empty(File)) {
-				auto Image = cv::imread(data(File));
-				std::cout << "[ Output Pattern ] " << Name << " (" << File << ")" << std::endl;
-				BG::Converter<>(Image).Create().OutputPattern(Name).OutputPatternPalette(Name).RestorePattern();
+				Console::Out() << "[ Output Pattern ] " << Name << " (" << File << ")" << std::endl;
+				const auto Image = ReadImage(File);
+				Converted.Get<BG::Converter<>>(Image, File)->OutputPattern(Name).OutputPatternPalette(Name).RestorePattern();
 			}
 		}
 		virtual void ProcessImageTileSet(std::string_view Name, std::string_view File, [[maybe_unused]] std::string_view Compression, [[maybe_unused]] std::string_view Option) override {
 			if (!empty(File)) {
-				auto Image = cv::imread(data(File));
-				std::cout << "[ Output Pattern ] " << Name << " (" << File << ")" << std::endl;
+				Console::Out() << "[ Output Pattern ] " << Name << " (" << File << ")" << std::endl;
+				const auto Image = ReadImage(File);
 				//!< C[W̏ꍇ̓p^[SقȂ肷̂ŁA}bv(BAT) 𕜌̂Ƒ債ĕςȂ
-				Image::Converter<>(Image).Create().OutputPattern(Name);
+				Converted.Get<Image::Converter<>>(Image, File)->OutputPattern(Name);
 			}
 		}
 		virtual void ProcessMap(std::string_view Name, std::string_view File, std::string_view TileSet, [[maybe_unused]] std::string_view Compression, [[maybe_unused]] const uint32_t Mapbase) override {
 			if (!empty(File)) {
-				auto Image = cv::imread(data(File));
-				std::cout << "[ Output Map ] " << Name << " (" << File << ")" << std::endl;
-				BG::Converter<>(Image).Create().OutputMap(Name).RestoreMap();
+				const auto Image = ReadImage(File);
+				Console::Out() << "[ Output Map ] " << Name << " (" << File << ")" << std::endl;
+				BG::Converter<>(Image).CreateIncremental(Name, [&]() { return Converted.Get<BG::Converter<>>(Image, File); }).OutputMap(Name).RestoreMap();
 			}
 		}
 		virtual void ProcessImageMap(std::string_view Name, std::string_view File, std::string_view TileSet, [[maybe_unused]] std::string_view Compression, [[maybe_unused]] const uint32_t Mapbase) override {
 			if (!empty(File)) {
-				auto Image = cv::imread(data(File));
-				std::cout << "[ Output BAT ] " << Name << " (" << File << ")" << std::endl;
-				Image::Converter<>(Image).Create().OutputBAT(Name).RestoreMap();
+				const auto Image = ReadImage(File);
+				Console::Out() << "[ Output BAT ] " << Name << " (" << File << ")" << std::endl;
+				Image::Converter<>(Image).CreateIncremental(Name, [&]() { return Converted.Get<Image::Converter<>>(Image, File); }).OutputBAT(Name).RestoreMap();
 			}
 		}
 		virtual void ProcessSprite(std::string_view Name, std::string_view File, const uint32_t Width, const uint32_t Height, [[maybe_unused]] std::string_view Compression, [[maybe_unused]] const uint32_t Time, [[maybe_unused]] std::string_view Collision, [[maybe_unused]] std::string_view Option, [[maybe_unused]] const uint32_t Iteration) override {
 			if (!empty(File)) {
-				auto Image = cv::imread(data(File));
-				std::cout << "[ Output Sprite ] " << Name << " (" << File << ")" << std::endl;
-
-				//!< 16x16, 16x32, 16x64, 32x16, 32x32, 32x64, 
-				switch (Width << 3) {
-				case 16:
-					switch (Height << 3) {
-					case 16:
-						Sprite::Converter<16, 16>(Image).Create().OutputPattern(Name).OutputPatternPalette(Name).OutputAnimation(Name).RestorePattern();
-						break;
-					case 32:
-						Sprite::Converter<16, 32>(Image).Create().OutputPattern(Name).OutputPatternPalette(Name).OutputAnimation(Name).RestorePattern();
-						break;
-					case 64:
-						Sprite::Converter<16, 64>(Image).Create().OutputPattern(Name).OutputPatternPalette(Name).OutputAnimation(Name).RestorePattern();
-						break;
-					default:
-						std::cerr << "Sprite size not supported" << std::endl;
-						break;
+				Console::Out() << "[ Output Sprite ] " << Name << " (" << File << ")" << std::endl;
+				const auto Image = ReadImage(File);
+
+				static constexpr auto Kernels = CreateSpriteKernels<ResourceReader>();
+				ProcessSpriteKernel(Kernels, Image, Name, Width << 3, Height << 3);
+			}
+		}
+
+		//!< 16x16, 16x32, 16x64, 32x16, 32x32, 32x64
+		static constexpr std::array<std::pair<uint8_t, uint8_t>, 6> SpriteSizes = { { { 16, 16 }, { 16, 32 }, { 16, 64 }, { 32, 16 }, { 32, 32 }, { 32, 64 } } };
+		template<uint8_t W, uint8_t H>
+		static void ConvertSprite(const cv::Mat& Image, std::string_view Name) {
+			Sprite::Converter<W, H>(Image).Create().OutputPattern(Name).OutputPatternPalette(Name).OutputAnimation(Name).RestorePattern();
+		}
+
+		//!< MAP  }bv (u8) + p^[ (16 x 16) + p^[̃pbgԍAIMAP  BAT + p^[ (8 x 8) 畜
+		virtual VERIFY VerifyMap(const VerifyEntry& Ent) const override {
+			if (empty(Ent.Palette)) { return VerifySkip("No PALETTE entry for " + Ent.File); }
+			const auto IsBG = "MAP" == Ent.Type;
+			if (IsBG == IsImagePalette) { return VerifySkip("PALETTE is converted for " + std::string(IsImagePalette ? "IMAP" : "MAP") + ", not for " + Ent.Type); }
+			std::vector<uint16_t> Pal, Words;
+			if (!ReadBin(Ent.Palette, Pal)) { return VerifyFail("Cannot read " + Ent.Palette + ".bin"); }
+			if (!ReadBin(Ent.TileSet, Words)) { return VerifyFail("Cannot read " + Ent.TileSet + ".bin"); }
+
+			std::vector<uint8_t> Map, PatPals;
+			std::vector<uint16_t> BAT;
+			if (IsBG) {
+				if (!ReadBin(Ent.Name, Map)) { return VerifyFail("Cannot read " + Ent.Name + ".bin"); }
+				if (!ReadBin(Ent.TileSet + ".pal", PatPals)) { return VerifyFail("Cannot read " + Ent.TileSet + ".pal.bin"); }
+			}
+			else {
+				if (!ReadBin(Ent.Name, BAT)) { return VerifyFail("Cannot read " + Ent.Name + ".bin"); }
+			}
+
+			const auto Image = ReadImage(Ent.File);
+			//!< BG  16 x 16 (8 x 8  LT, RT, LB, RB ̏ 4 )AC[W 8 x 8
+			const auto TileSize = IsBG ? 16 : 8;
+			const auto WordsPerPattern = static_cast<size_t>(IsBG ? 64 : 16);
+			const cv::Size MapSize(Image.cols / TileSize, Image.rows / TileSize);
+			if ((IsBG ? size(Map) : size(BAT)) != static_cast<size_t>(MapSize.area())) { return VerifyFail("Map size does not match " + Ent.File); }
+
+			const cv::Size Size(MapSize.width * TileSize, MapSize.height * TileSize);
+			std::vector<uint16_t> Plane(static_cast<size_t>(Size.area()));
+			for (auto r = 0; r < MapSize.height; ++r) {
+				for (auto c = 0; c < MapSize.width; ++c) {
+					const auto k = static_cast<size_t>(r) * MapSize.width + c;
+					uint32_t PatIdx = 0, PalIdx = 0;
+					if (IsBG) {
+						PatIdx = Map[k];
+						if (PatIdx >= size(PatPals)) { return VerifyFail("Pattern palette index out of range"); }
+						PalIdx = PatPals[PatIdx] >> 4;
+					}
+					else {
+						//!< Avgpłp^[CfbNX 256 ȍ~
+						if ((BAT[k] & 0xfff) < 256) { return VerifyFail("BAT pattern index out of range"); }
+						PatIdx = (BAT[k] & 0xfff) - 256;
+						PalIdx = BAT[k] >> 12;
 					}
-					break;
-				case 32:
-					switch (Height << 3) {
-					case 16:
-						Sprite::Converter<32, 16>(Image).Create().OutputPattern(Name).OutputPatternPalette(Name).OutputAnimation(Name).RestorePattern();
-						break;
-					case 32:
-						Sprite::Converter<32, 32>(Image).Create().OutputPattern(Name).OutputPatternPalette(Name).OutputAnimation(Name).RestorePattern();
-						break;
-					case 64:
-						Sprite::Converter<32, 64>(Image).Create().OutputPattern(Name).OutputPatternPalette(Name).OutputAnimation(Name).RestorePattern();
-						break;
-					default:
-						std::cerr << "Sprite size not supported" << std::endl;
-						break;
+					if ((PatIdx + 1) * WordsPerPattern > size(Words)) { return VerifyFail("Pattern index out of range"); }
+
+					for (auto y = 0; y < TileSize; ++y) {
+						for (auto x = 0; x < TileSize; ++x) {
+							//!< EncodeTile8x8() ̋tAu16[i] ̉ʏʂփv[ 0, 1Au16[8 + i] փv[ 2, 3
+							const auto Tile = &Words[PatIdx * WordsPerPattern + ((y >> 3) * 2 + (x >> 3)) * 16];
+							const auto i = y & 7, Bit = 7 - (x & 7);
+							const auto Index = ((Tile[i] >> Bit) & 1) | (((Tile[i] >> (8 + Bit)) & 1) << 1) | (((Tile[8 + i] >> Bit) & 1) << 2) | (((Tile[8 + i] >> (8 + Bit)) & 1) << 3);
+							const auto PalPos = static_cast<size_t>(PalIdx) * Traits::PaletteColorCount + Index;
+							if (PalPos >= size(Pal)) { return VerifyFail("Palette index out of range"); }
+							Plane[static_cast<size_t>(r * TileSize + y) * Size.width + c * TileSize + x] = Pal[PalPos];
+						}
 					}
-					break;
-				default: 
-					std::cerr << "Sprite size not supported" << std::endl;
-					break;
 				}
 			}
+			return Compare<Traits>(Image, Size, Plane);
 		}
 		virtual void ClearTileSet(std::string_view Name) override {
 			Super::ClearTileSet(Name);
@@ -1164,6 +3425,25 @@ namespace FC {
 		TO_BGR(0,   0,   0),
 	};
 #undef TO_BGR
+	//!< ԋ߂F̃CfbNXe[u (gpɍ쐬)
+	static const NearestColorTable<size(ColorEntries)>& GetColorTable() {
+		static const NearestColorTable Table(ColorEntries);
+		return Table;
+	}
+
+	//!< F̓J[e[ũCfbNX
+	struct Traits
+	{
+		static constexpr std::string_view Name = "FC";
+		static constexpr uint32_t ColorCount = static_cast<uint32_t>(size(ColorEntries)); //!< J[e[ũCfbNX
+		static constexpr uint16_t PaletteCount = 4;
+		static constexpr uint16_t PaletteColorCount = 4;
+		static constexpr uint16_t PaletteReservedColorCount = 1; //!< 擪͓F (wiF)
+
+		//!< ԋ߂F̃CfbNXԂ
+		static uint16_t ToPlatformColor(const cv::Vec3b& Color) { return GetColorTable().Find(Color); }
+		static cv::Vec3b FromPlatformColor(const uint16_t Index) { return Index < size(ColorEntries) ? ColorEntries[Index] : cv::Vec3b(0, 0, 0); }
+	};
 
 	//!< 2 v[ɕďóA2 v[킹ƃJ[CfbNX܂
 	//!< p^[ 8 x 8 \̂
@@ -1181,85 +3461,61 @@ namespace FC {
 	public:
 		ConverterBase(const cv::Mat& Img) : Super(Img) {}
 
-		//!< ԋ߂F̃CfbNXԂ
-		virtual uint16_t ToPlatformColor(const cv::Vec3b& Color) const override {
-			uint8_t Index = 0xff;
-			float minDistSq = std::numeric_limits<float>::max();
-			for (auto i = 0; i < size(ColorEntries); ++i) {
-				const auto d = cv::Vec3f(ColorEntries[i]) - cv::Vec3f(Color);
-				const auto distSq = d.dot(d);
-				if (distSq < minDistSq) {
-					minDistSq = distSq;
-					Index = i;
-				}
-			}
-			return Index;
-		}
-		virtual cv::Vec3b FromPlatformColor(const uint16_t& Index) const override {
-			if (Index < size(ColorEntries)) {
-				return ColorEntries[Index];
+		virtual std::string_view GetPlatformName() const override final { return Traits::Name; }
+
+		virtual uint16_t ToPlatformColor(const cv::Vec3b& Color) const override final { return Traits::ToPlatformColor(Color); }
+		virtual void ToPlatformColorPlane(std::vector<uint16_t>& Plane, const cv::Mat& Img) const override {
+			Plane.resize(Img.total());
+			const auto& Table = GetColorTable();
+			for (auto i = 0; i < Img.rows; ++i) {
+				std::ranges::transform(Img.ptr<cv::Vec3b>(i), Img.ptr<cv::Vec3b>(i) + Img.cols, &Plane[i * Img.cols], [&](const cv::Vec3b& rhs) { return Table.Find(rhs); });
 			}
-			return cv::Vec3b(0, 0, 0);
 		}
+		virtual cv::Vec3b FromPlatformColor(const uint16_t& Index) const override final { return Traits::FromPlatformColor(Index); }
+		virtual uint32_t GetPlatformColorCount() const override final { return Traits::ColorCount; }
 
-		virtual uint16_t GetPaletteCount() const override { return 4; };
-		virtual uint16_t GetPaletteColorCount() const override { return 4; }
+		virtual uint16_t GetPaletteCount() const override final { return Traits::PaletteCount; };
+		virtual uint16_t GetPaletteColorCount() const override final { return Traits::PaletteColorCount; }
+		virtual bool HasPaletteReservedColor() const override final { return 0 < Traits::PaletteReservedColorCount; }
+		virtual uint16_t GetPaletteReservedColorCount() const override final { return Traits::PaletteReservedColorCount; }
 
 		virtual ConverterBase& CreatePattern() override {
 			Super::CreatePattern();
 			//assert(size(this->Patterns) <= 256);
 			if (size(this->Patterns) > 256) {
-				std::cerr << "\tPattern count " << size(this->Patterns) << " > 256" << std::endl;
+				Console::Err() << "\tPattern count " << size(this->Patterns) << " > 256" << std::endl;
 			}
 			return *this;
 		}
 
 		virtual const ConverterBase& OutputPalette(std::string_view Name) const override {
+			Trace::Scope Span("OutputPalette");
 			this->OutputPaletteOfType<uint8_t>(Name);
 			return *this;
 		}
 		virtual const ConverterBase& OutputPattern(std::string_view Name) const override {
-			std::cout << "\tPattern count = " << size(this->Patterns) << std::endl;
-			std::cout << "\tSprite size = " << static_cast<uint16_t>(W) << " x " << static_cast<uint16_t>(H) << std::endl;
-
-			std::ofstream OutBin(data(std::string(Name) + ".bin"), std::ios::binary | std::ios::out);
-			assert(!OutBin.bad());
-			std::ofstream OutText(data(std::string(Name) + ".txt"), std::ios::out);
-			assert(!OutText.bad());
+			Trace::Scope Span("OutputPattern");
+			Console::Out() << "\tPattern count = " << size(this->Patterns) << std::endl;
+			Console::Out() << "\tSprite size = " << static_cast<uint16_t>(W) << " x " << static_cast<uint16_t>(H) << std::endl;
 
-			//OutText << "const " << typeid(uint8_t).name() << " " << Name << "[] = {" << std::endl;
-			OutText << "const u" << (sizeof(uint8_t) << 3) << " " << Name << "[] = {" << std::endl;
-
-			for (auto pat = 0; pat < size(this->Patterns); ++pat) {
-				const auto& Pat = this->Patterns[pat];
+			std::vector<uint8_t> Words;
+			Words.reserve(size(this->Patterns) * 2 * H);
+			for (const auto& Pat : this->Patterns) {
 				assert(Pat.HasValidPaletteIndex());
 
 				//!< p^[̃pbgCfbNXo
-				std::cout << "\t\tPalette index = " << Pat.PaletteIndex << std::endl;
+				Console::Out() << "\t\tPalette index = " << Pat.PaletteIndex << std::endl;
 
 				//!< 2 v[
+				const auto Rows = BitPlane::Gather<8>(Pat.ColorIndices, 0, Traits::PaletteReservedColorCount); //!< 擪̓Fl
 				for (auto pl = 0; pl < 2; ++pl) {
-					OutText << "\t";
-					for (auto i = 0; i < size(Pat.ColorIndices); ++i) {
-						uint8_t Plane = 0;
-						for (auto j = 0; j < size(Pat.ColorIndices[i]); ++j) {
-							const auto ColorIndex = Pat.ColorIndices[i][j] + this->GetPaletteReservedColorCount(); //!< 擪̓Fl
-							const auto Shift = 7 - j;
-							const auto Mask = 1 << pl;
-							Plane |= ((ColorIndex & Mask) ? 1 : 0) << Shift;
-						}
-						OutText << "0x" << std::hex << std::setw(sizeof(Plane) << 1) << std::right << std::setfill('0') << static_cast<uint16_t>(Plane);
-						if (size(this->Patterns) - 1 > pat || 1 > pl || size(Pat.ColorIndices) - 1 > i) { OutText << ", "; }
-
-						OutBin.write(reinterpret_cast<const char*>(&Plane), sizeof(Plane));
+					for (auto i = 0; i < H; ++i) {
+						Words.emplace_back(static_cast<uint8_t>(Rows[i][pl]));
 					}
 				}
-				OutText << std::endl;
 			}
-			OutText << "};" << std::endl;
-
-			OutBin.close();
-			OutText.close();
+			//!< 2 v[ŉs
+			this->OutputPatternOfType(Name, Words, H, 2);
 
 			return *this;
 		}
@@ -1286,61 +3542,58 @@ namespace FC {
 			virtual Converter& Create() override { Super::Create(); return *this; }
 
 			virtual const Converter& OutputBAT(std::string_view Name) const override {
-				std::cout << "\tBAT size = " << size(this->Map[0]) << " x " << size(this->Map) << std::endl;
+				Trace::Scope Span("OutputBAT");
+				Console::Out() << "\tBAT size = " << this->Map.GetWidth() << " x " << this->Map.GetHeight() << std::endl;
 
-				std::ofstream OutBin(data(std::string(Name) + ".bin"), std::ios::binary | std::ios::out);
-				assert(!OutBin.bad());
-				std::ofstream OutText(data(std::string(Name) + ".txt"), std::ios::out);
-				assert(!OutText.bad());
+				OutputBuffer Out(Name);
 
-				//OutText << "const " << typeid(uint8_t).name() << " " << Name << "[] = {" << std::endl;
-				OutText << "const u" << (sizeof(uint8_t) << 3) << " " << Name << "[] = {" << std::endl;
+				Out.Header<uint8_t>(Name);
 
 				//!< 4 x 4  1  uint8_t Ŏw
-				for (auto i = 0; i < size(this->Map); i += 4) {
-					for (auto j = 0; j < size(this->Map[i]); j += 4) {
+				for (auto i = 0; i < this->Map.GetHeight(); i += 4) {
+					for (auto j = 0; j < this->Map.GetWidth(); j += 4) {
 						//!< 2 x 2  uint8_t  2 rbgŎw ( 2 x 2 ͓pbgԍłȂƂȂ)
-						const auto LTLT = static_cast<uint8_t>(this->Map[i + 0][j + 0].PatternIndex);
-						const auto LTRT = static_cast<uint8_t>(this->Map[i + 0][j + 1].PatternIndex);
-						const auto LTLB = static_cast<uint8_t>(this->Map[i + 1][j + 0].PatternIndex);
-						const auto LTRB = static_cast<uint8_t>(this->Map[i + 1][j + 1].PatternIndex);
+						const auto LTLT = static_cast<uint8_t>(this->Map(i + 0, j + 0).PatternIndex);
+						const auto LTRT = static_cast<uint8_t>(this->Map(i + 0, j + 1).PatternIndex);
+						const auto LTLB = static_cast<uint8_t>(this->Map(i + 1, j + 0).PatternIndex);
+						const auto LTRB = static_cast<uint8_t>(this->Map(i + 1, j + 1).PatternIndex);
 						//!< 2 x 2 pbgԍɂȂĂȂꍇ assert
 						//assert(this->Patterns[LTLT].PaletteIndex == this->Patterns[LTRT].PaletteIndex == this->Patterns[LTLB].PaletteIndex == this->Patterns[LTRB].PaletteIndex);
 						if (this->Patterns[LTLT].PaletteIndex != this->Patterns[LTRT].PaletteIndex ||
 							this->Patterns[LTLT].PaletteIndex != this->Patterns[LTLB].PaletteIndex ||
 							this->Patterns[LTLT].PaletteIndex != this->Patterns[LTRB].PaletteIndex) {
-							std::cerr << "\t2x2 is not using same palette index" << std::endl;
+							Console::Err() << "\t2x2 is not using same palette index" << std::endl;
 						}
 
-						const auto RTLT = static_cast<uint8_t>(this->Map[i + 0][j + 2].PatternIndex);
-						const auto RTRT = static_cast<uint8_t>(this->Map[i + 0][j + 3].PatternIndex);
-						const auto RTLB = static_cast<uint8_t>(this->Map[i + 1][j + 2].PatternIndex);
-						const auto RTRB = static_cast<uint8_t>(this->Map[i + 1][j + 3].PatternIndex);
+						const auto RTLT = static_cast<uint8_t>(this->Map(i + 0, j + 2).PatternIndex);
+						const auto RTRT = static_cast<uint8_t>(this->Map(i + 0, j + 3).PatternIndex);
+						const auto RTLB = static_cast<uint8_t>(this->Map(i + 1, j + 2).PatternIndex);
+						const auto RTRB = static_cast<uint8_t>(this->Map(i + 1, j + 3).PatternIndex);
 						//assert(this->Patterns[RTLT].PaletteIndex == this->Patterns[RTRT].PaletteIndex == this->Patterns[RTLB].PaletteIndex == this->Patterns[RTRB].PaletteIndex);
 						if (this->Patterns[RTLT].PaletteIndex != this->Patterns[RTRT].PaletteIndex ||
 							this->Patterns[RTLT].PaletteIndex != this->Patterns[RTLB].PaletteIndex ||
 							this->Patterns[RTLT].PaletteIndex != this->Patterns[RTRB].PaletteIndex) {
-							std::cerr << "\t2x2 is not using same palette index" << std::endl;
+							Console::Err() << "\t2x2 is not using same palette index" << std::endl;
 						}
 
-						const auto LBLT = static_cast<uint8_t>(this->Map[i + 2][j + 0].PatternIndex);
-						const auto LBRT = static_cast<uint8_t>(this->Map[i + 2][j + 1].PatternIndex);
-						const auto LBLB = static_cast<uint8_t>(this->Map[i + 3][j + 0].PatternIndex);
-						const auto LBRB = static_cast<uint8_t>(this->Map[i + 3][j + 1].PatternIndex);
+						const auto LBLT = static_cast<uint8_t>(this->Map(i + 2, j + 0).PatternIndex);
+						const auto LBRT = static_cast<uint8_t>(this->Map(i + 2, j + 1).PatternIndex);
+						const auto LBLB = static_cast<uint8_t>(this->Map(i + 3, j + 0).PatternIndex);
+						const auto LBRB = static_cast<uint8_t>(this->Map(i + 3, j + 1).PatternIndex);
 						//assert(this->Patterns[LBLT].PaletteIndex == this->Patterns[LBRT].PaletteIndex == this->Patterns[LBLB].PaletteIndex == this->Patterns[LBRB].PaletteIndex);
 						if (this->Patterns[LBLT].PaletteIndex != this->Patterns[LBRT].PaletteIndex == this->Patterns[LBLB].PaletteIndex == this->Patterns[LBRB].PaletteIndex) {
-							std::cerr << "\t2x2 is not using same palette index" << std::endl;
+							Console::Err() << "\t2x2 is not using same palette index" << std::endl;
 						}
 
-						const auto RBLT = static_cast<uint8_t>(this->Map[i + 2][j + 2].PatternIndex);
-						const auto RBRT = static_cast<uint8_t>(this->Map[i + 2][j + 3].PatternIndex);
-						const auto RBLB = static_cast<uint8_t>(this->Map[i + 3][j + 2].PatternIndex);
-						const auto RBRB = static_cast<uint8_t>(this->Map[i + 3][j + 3].PatternIndex);
+						const auto RBLT = static_cast<uint8_t>(this->Map(i + 2, j + 2).PatternIndex);
+						const auto RBRT = static_cast<uint8_t>(this->Map(i + 2, j + 3).PatternIndex);
+						const auto RBLB = static_cast<uint8_t>(this->Map(i + 3, j + 2).PatternIndex);
+						const auto RBRB = static_cast<uint8_t>(this->Map(i + 3, j + 3).PatternIndex);
 						//assert(this->Patterns[RBLT].PaletteIndex == this->Patterns[RBRT].PaletteIndex == this->Patterns[RBLB].PaletteIndex == this->Patterns[RBRB].PaletteIndex);
 						if (this->Patterns[RBLT].PaletteIndex != this->Patterns[RBRT].PaletteIndex ||
 							this->Patterns[RBLT].PaletteIndex != this->Patterns[RBLB].PaletteIndex ||
 							this->Patterns[RBLT].PaletteIndex != this->Patterns[RBRB].PaletteIndex) {
-							std::cerr << "\t2x2 is not using same palette index" << std::endl;
+							Console::Err() << "\t2x2 is not using same palette index" << std::endl;
 						}
 
 						assert(this->Patterns[RBLT].HasValidPaletteIndex());
@@ -1349,17 +3602,16 @@ namespace FC {
 						assert(this->Patterns[LTLT].HasValidPaletteIndex());
 						const uint8_t BAT = (this->Patterns[RBLT].PaletteIndex << 6) | (this->Patterns[LBLT].PaletteIndex << 4) | (this->Patterns[RTLT].PaletteIndex << 2) | this->Patterns[LTLT].PaletteIndex;
 
-						OutText << "0x" << std::hex << std::setw(sizeof(BAT) << 1) << std::right << std::setfill('0') << static_cast<uint16_t>(BAT);
-						if (size(this->Map) - 1 > i || size(this->Map[i]) - 1 > j) { OutText << ", "; }
+						Out.Hex(BAT);
+						if (this->Map.GetHeight() - 1 > i || this->Map.GetWidth() - 1 > j) { Out << ", "; }
 
-						OutBin.write(reinterpret_cast<const char*>(&BAT), sizeof(BAT));
+						Out.Write(BAT);
 					}
-					OutText << std::endl;
+					Out << "\n";
 				}
-				OutText << "};" << std::endl;
+				Out.Footer();
 
-				OutBin.close();
-				OutText.close();
+				Out.Close();
 
 				return *this;
 			}
@@ -1377,6 +3629,9 @@ namespace FC {
 		public:
 			Converter(const cv::Mat& Img) : Super(Img) {}
 
+			//!< XvCg͔]\\ (OAM ̑)
+			virtual bool IsFlipSupported() const override { return true; }
+
 			virtual Converter& Create() override { Super::Create(); return *this; }
 		};
 	}
@@ -1386,57 +3641,56 @@ namespace FC {
 	private:
 		using Super = ResourceReaderBase;
 	public:
+		virtual std::string_view GetPlatformName() const override { return "FC"; }
+		virtual ReduceFunc GetReduceFunc(std::string_view Type) const override {
+			if ("TILESET" == Type) { return &ReduceColor<BG::Converter<>>; }
+			if ("SPRITE" == Type) { return &ReduceColor<Sprite::Converter<8, 8>>; }
+			return nullptr;
+		}
+
 		virtual void ProcessPalette(std::string_view Name, std::string_view File) override {
 			if (!empty(File)) {
-				auto Image = cv::imread(data(File));
-				std::cout << "[ Output Palette ] " << Name << " (" << File << ")" << std::endl;
+				const auto Image = ReadImage(File);
+				Console::Out() << "[ Output Palette ] " << Name << " (" << File << ")" << std::endl;
 
-				BG::Converter<>(Image).Create().OutputPalette(Name).RestorePalette();
+				Converted.Get<BG::Converter<>>(Image, File)->OutputPalette(Name).RestorePalette();
 			}
 		}
 		virtual void ProcessTileSet(std::string_view Name, std::string_view File, [[maybe_unused]] std::string_view Compression, [[maybe_unused]] std::string_view Option) override {
 			if (!empty(File)) {
-				auto Image = cv::imread(data(File));
-				std::cout << "[ Output Pattern ] " << Name << " (" << File << ")" << std::endl;
+				Console::Out() << "[ Output Pattern ] " << Name << " (" << File << ")" << std::endl;
+				const auto Image = ReadImage(File);
 
-				BG::Converter<>(Image).Create().OutputPattern(Name).RestorePattern();
+				Converted.Get<BG::Converter<>>(Image, File)->OutputPattern(Name).RestorePattern();
 			}
 		}
 		virtual void ProcessMap(std::string_view Name, std::string_view File, std::string_view TileSet, [[maybe_unused]] std::string_view Compression, [[maybe_unused]] const uint32_t Mapbase) override {
 			if (!empty(File)) {
-				auto Image = cv::imread(data(File));
+				const auto Image = ReadImage(File);
 
-				std::cout << "[ Output BAT ] " << Name << " (" << File << ")" << std::endl;
-				BG::Converter<>(Image).Create().OutputBAT(Name).RestoreMap();
+				Console::Out() << "[ Output BAT ] " << Name << " (" << File << ")" << std::endl;
+				BG::Converter<>(Image).CreateIncremental(Name, [&]() { return Converted.Get<BG::Converter<>>(Image, File); }).OutputBAT(Name).RestoreMap();
 			}
 		}
 		virtual void ProcessSprite(std::string_view Name, std::string_view File, const uint32_t Width, const uint32_t Height, [[maybe_unused]] std::string_view Compression, [[maybe_unused]] const uint32_t Time, [[maybe_unused]] std::string_view Collision, [[maybe_unused]] std::string_view Option, [[maybe_unused]] const uint32_t Iteration) override {
 			if (!empty(File)) {
-				auto Image = cv::imread(data(File));
-				std::cout << "[ Output Sprite ] " << Name << " (" << File << ")" << std::endl;
+				Console::Out() << "[ Output Sprite ] " << Name << " (" << File << ")" << std::endl;
+				const auto Image = ReadImage(File);
 
-				//!< 8x8 or 8x16
-				switch (Width << 3)
-				{
-				case 8:
-					switch (Height << 3) {
-					case 8:
-						Sprite::Converter<8, 8>(Image).Create().OutputPattern(Name).OutputAnimation(Name).RestorePattern();
-						break;
-					case 16:
-						Sprite::Converter<8, 16>(Image).Create().OutputPattern(Name).OutputAnimation(Name).RestorePattern();
-						break;
-					default:
-						std::cerr << "Sprite size not supported" << std::endl;
-						break;
-					}
-					break;
-				default:
-					std::cerr << "Sprite size not supported" << std::endl;
-					break;
-				}
+				static constexpr auto Kernels = CreateSpriteKernels<ResourceReader>();
+				ProcessSpriteKernel(Kernels, Image, Name, Width << 3, Height << 3);
 			}
 		}
+
+		//!< 8x8 or 8x16
+		static constexpr std::array<std::pair<uint8_t, uint8_t>, 2> SpriteSizes = { { { 8, 8 }, { 8, 16 } } };
+		template<uint8_t W, uint8_t H>
+		static void ConvertSprite(const cv::Mat& Image, std::string_view Name) {
+			Sprite::Converter<W, H>(Image).Create().OutputPattern(Name).OutputAnimation(Name).RestorePattern();
+		}
+
+		//!< }bvƂĂ̓Agr[g (pbgԍ) ݂̂o͂ĂāAl[e[u (p^[ԍ) ̂ŕłȂ
+		virtual VERIFY VerifyMap([[maybe_unused]] const VerifyEntry& Ent) const override { return VerifySkip("Map output has no name table (attribute table only)"); }
 	};
 }
 #pragma endregion //!< FC
@@ -1457,6 +3711,22 @@ namespace GB
 		TO_BGR(155, 188, 15),
 	};
 #undef TO_BGR
+	static const NearestColorTable<size(ColorEntries)>& GetColorTable() {
+		static const NearestColorTable Table(ColorEntries);
+		return Table;
+	}
+
+	//!< F̓J[e[ũCfbNXApbgA\F̗L BG ƃXvCgňقȂ̂ŕϊ푤Ō߂
+	struct Traits
+	{
+		static constexpr std::string_view Name = "GB";
+		static constexpr uint32_t ColorCount = static_cast<uint32_t>(size(ColorEntries)); //!< J[e[ũCfbNX
+		static constexpr uint16_t PaletteColorCount = 4;
+
+		static uint16_t ToPlatformColor(const cv::Vec3b& Color) { return GetColorTable().Find(Color); }
+		static cv::Vec3b FromPlatformColor(const uint16_t Index) { return Index < size(ColorEntries) ? ColorEntries[Index] : cv::Vec3b(0, 0, 0); }
+	};
+
 	template<uint8_t W, uint8_t H>
 	class ConverterBase : public Converter<W, H>
 	{
@@ -1465,57 +3735,48 @@ namespace GB
 	public:
 		ConverterBase(const cv::Mat& Img) : Super(Img) {}
 
-		virtual uint16_t ToPlatformColor(const cv::Vec3b& Color) const override {
-			uint8_t Index = 0xff;
-			float minDistSq = std::numeric_limits<float>::max();
-			for (auto i = 0; i < size(ColorEntries); ++i) {
-				const auto d = cv::Vec3f(ColorEntries[i]) - cv::Vec3f(Color);
-				const auto distSq = d.dot(d);
-				if (distSq < minDistSq) {
-					minDistSq = distSq;
-					Index = i;
-				}
-			}
-			return Index;
-		}
-		virtual cv::Vec3b FromPlatformColor(const uint16_t& Index) const override {
-			if (Index < size(ColorEntries)) {
-				return ColorEntries[Index];
+		virtual std::string_view GetPlatformName() const override final { return Traits::Name; }
+
+		virtual uint16_t ToPlatformColor(const cv::Vec3b& Color) const override final { return Traits::ToPlatformColor(Color); }
+		virtual void ToPlatformColorPlane(std::vector<uint16_t>& Plane, const cv::Mat& Img) const override {
+			Plane.resize(Img.total());
+			const auto& Table = GetColorTable();
+			for (auto i = 0; i < Img.rows; ++i) {
+				std::ranges::transform(Img.ptr<cv::Vec3b>(i), Img.ptr<cv::Vec3b>(i) + Img.cols, &Plane[i * Img.cols], [&](const cv::Vec3b& rhs) { return Table.Find(rhs); });
 			}
-			return cv::Vec3b(0, 0, 0);
 		}
+		virtual cv::Vec3b FromPlatformColor(const uint16_t& Index) const override final { return Traits::FromPlatformColor(Index); }
+		virtual uint32_t GetPlatformColorCount() const override final { return Traits::ColorCount; }
 
 		virtual uint16_t GetPaletteCount() const override { return 1; };
-		virtual uint16_t GetPaletteColorCount() const override { return 4; }
+		virtual uint16_t GetPaletteColorCount() const override final { return Traits::PaletteColorCount; }
 
 		virtual ConverterBase& CreatePattern() override {
 			Super::CreatePattern();
 
 			if (size(this->Patterns) > 128) {
 				//!< p̃p^[̈gpKv
-				std::cerr << "Pattern count = " << size(this->Patterns) << " > 128" << std::endl;
+				Console::Err() << "Pattern count = " << size(this->Patterns) << " > 128" << std::endl;
 			}
 			//!< p̃p^[̈gpĂȂ
 			//assert(size(this->Patterns) <= 256);
 			if (size(this->Patterns) > 256) {
-				std::cerr << "\tPattern count " << size(this->Patterns) << " > 256" << std::endl;
+				Console::Err() << "\tPattern count " << size(this->Patterns) << " > 256" << std::endl;
 			}
 			return *this;
 		}
 
 		virtual const ConverterBase& OutputPalette(std::string_view Name) const override {
-			std::cout << "\tPalette count = " << size(this->Palettes) << " / " << GetPaletteCount() << (size(this->Palettes) > GetPaletteCount() ? " warning" : "") << std::endl;
+			Trace::Scope Span("OutputPalette");
+			Console::Out() << "\tPalette count = " << size(this->Palettes) << " / " << GetPaletteCount() << (size(this->Palettes) > GetPaletteCount() ? " warning" : "") << std::endl;
 
-			std::ofstream OutBin(data(std::string(Name) + ".bin"), std::ios::binary | std::ios::out);
-			assert(!OutBin.bad());
-			std::ofstream OutText(data(std::string(Name) + ".txt"), std::ios::out);
-			assert(!OutText.bad());
+			OutputBuffer Out(Name);
 
-			OutText << "const u" << (sizeof(uint8_t) << 3) << " " << Name << "[] = {" << std::endl;
+			Out.Header<uint8_t>(Name);
 
 			for (auto i = 0; i < size(this->Palettes); ++i) {
 				const auto MaxCount = this->GetPaletteColorCount() - this->GetPaletteReservedColorCount();
-				std::cout << "\t\tPalette color count = " << size(this->Palettes[i]) << " / " << MaxCount << (size(this->Palettes[i]) > MaxCount ? " warning" : "") << std::endl;
+				Console::Out() << "\t\tPalette color count = " << size(this->Palettes[i]) << " / " << MaxCount << (size(this->Palettes[i]) > MaxCount ? " warning" : "") << std::endl;
 
 				const uint8_t TransparentColor = 0; //!< 擪F (ł 0 ƂĂ)
 
@@ -1532,66 +3793,47 @@ namespace GB
 				}
 
 				//!< o
-				OutText << "\t";
+				Out << "\t";
 				uint8_t PalMask = 0;
 				for (auto j = 0; j < size(PalOut); ++j) {
 					PalMask |= static_cast<uint16_t>(PalOut[j]) << (j << 1);
 				}
-				OutText << "0x" << std::hex << std::setw(sizeof(PalMask) << 1) << std::right << std::setfill('0') << static_cast<uint16_t>(PalMask);
-				if (size(this->Palettes) - 1 > i) { OutText << ", "; }
-				OutText << std::endl;
+				Out.Hex(PalMask);
+				if (size(this->Palettes) - 1 > i) { Out << ", "; }
+				Out << "\n";
 
-				OutBin.write(reinterpret_cast<const char*>(&PalMask), sizeof(PalMask));
+				Out.Write(PalMask);
 			}
-			OutText << "};" << std::endl;
+			Out.Footer();
 
-			OutBin.close();
-			OutText.close();
+			Out.Close();
 
 			return *this;
 		}
 		virtual const ConverterBase& OutputPattern(std::string_view Name) const override {
-			std::cout << "\tPattern count = " << size(this->Patterns) << std::endl;
-			std::cout << "\tSprite size = " << static_cast<uint16_t>(W) << " x " << static_cast<uint16_t>(H) << std::endl;
-
-			std::ofstream OutBin(data(std::string(Name) + ".bin"), std::ios::binary | std::ios::out);
-			assert(!OutBin.bad());
-			std::ofstream OutText(data(std::string(Name) + ".txt"), std::ios::out);
-			assert(!OutText.bad());
-
-			//OutText << "const " << typeid(uint8_t).name() << " " << Name << "[] = {" << std::endl;
-			OutText << "const u" << (sizeof(uint8_t) << 3) << " " << Name << "[] = {" << std::endl;
-
-			for (auto pat = 0; pat < size(this->Patterns); ++pat) {
-				const auto& Pat = this->Patterns[pat];
+			Trace::Scope Span("OutputPattern");
+			Console::Out() << "\tPattern count = " << size(this->Patterns) << std::endl;
+			Console::Out() << "\tSprite size = " << static_cast<uint16_t>(W) << " x " << static_cast<uint16_t>(H) << std::endl;
+
+			std::vector<uint8_t> Words;
+			Words.reserve(size(this->Patterns) * 2 * H);
+			const auto Reserved = this->GetPaletteReservedColorCount(); //!< BG ƃXvCgňقȂ
+			for (const auto& Pat : this->Patterns) {
 				assert(Pat.HasValidPaletteIndex());
 
 				//!< p^[̃pbgCfbNXo
-				std::cout << "\t\tPalette index = " << Pat.PaletteIndex << std::endl;
+				Console::Out() << "\t\tPalette index = " << Pat.PaletteIndex << std::endl;
 
-				OutText << "\t";
-				for (auto i = 0; i < size(Pat.ColorIndices); ++i) {
-					//!< 2 v[ (GB ł̓v[܂Ƃ߂ďo͂ł͂ȂA݂ɏo)
+				//!< 2 v[ (GB ł̓v[܂Ƃ߂ďo͂ł͂ȂA݂ɏo)
+				const auto Rows = BitPlane::Gather<8>(Pat.ColorIndices, 0, Reserved); //!< 擪̓Fl
+				for (auto i = 0; i < H; ++i) {
 					for (auto pl = 0; pl < 2; ++pl) {
-						uint8_t Plane = 0;
-						for (auto j = 0; j < size(Pat.ColorIndices[i]); ++j) {
-							const auto ColorIndex = Pat.ColorIndices[i][j] + this->GetPaletteReservedColorCount(); //!< 擪̓Fl
-							const auto Shift = 7 - j;
-							const auto Mask = 1 << pl;
-							Plane |= ((ColorIndex & Mask) ? 1 : 0) << Shift;
-						}
-						OutText << "0x" << std::hex << std::setw(sizeof(Plane) << 1) << std::right << std::setfill('0') << static_cast<uint16_t>(Plane);
-						if (size(this->Patterns) - 1 > pat || 1 > pl || size(Pat.ColorIndices) - 1 > i) { OutText << ", "; }
-
-						OutBin.write(reinterpret_cast<const char*>(&Plane), sizeof(Plane));
+						Words.emplace_back(static_cast<uint8_t>(Rows[i][pl]));
 					}
 				}
-				OutText << std::endl;
 			}
-			OutText << "};" << std::endl;
-
-			OutBin.close();
-			OutText.close();
+			//!< p^[ɉs
+			this->OutputPatternOfType(Name, Words, H << 1, 1);
 
 			return *this;
 		}
@@ -1624,6 +3866,9 @@ namespace GB
 
 			virtual uint16_t GetPaletteCount() const override { return 2; };
 
+			//!< XvCg͔]\\ (OAM ̑)
+			virtual bool IsFlipSupported() const override { return true; }
+
 			virtual Converter& Create() override { Super::Create(); return *this; }
 		};
 	}
@@ -1633,61 +3878,345 @@ namespace GB
 	private:
 		using Super = ResourceReaderBase;
 	public:
+		virtual std::string_view GetPlatformName() const override { return "GB"; }
+		virtual ReduceFunc GetReduceFunc(std::string_view Type) const override {
+			if ("TILESET" == Type) { return &ReduceColor<BG::Converter<>>; }
+			if ("SPRITE" == Type) { return &ReduceColor<Sprite::Converter<8, 8>>; }
+			return nullptr;
+		}
+
 		virtual void ProcessPalette(std::string_view Name, std::string_view File) override {
 			if (!empty(File)) {
-				auto Image = cv::imread(data(File));
-				std::cout << "[ Output Palette ] " << Name << " (" << File << ")" << std::endl;
+				const auto Image = ReadImage(File);
+				Console::Out() << "[ Output Palette ] " << Name << " (" << File << ")" << std::endl;
 
-				BG::Converter<>(Image).Create().OutputPalette(Name).RestorePalette();
+				Converted.Get<BG::Converter<>>(Image, File)->OutputPalette(Name).RestorePalette();
 			}
 		}
 		virtual void ProcessTileSet(std::string_view Name, std::string_view File, [[maybe_unused]] std::string_view Compression, [[maybe_unused]] std::string_view Option) override {
 			if (!empty(File)) {
-				auto Image = cv::imread(data(File));
-				std::cout << "[ Output Pattern ] " << Name << " (" << File << ")" << std::endl;
+				Console::Out() << "[ Output Pattern ] " << Name << " (" << File << ")" << std::endl;
+				const auto Image = ReadImage(File);
 
-				BG::Converter<>(Image).Create().OutputPattern(Name).RestorePattern();
+				Converted.Get<BG::Converter<>>(Image, File)->OutputPattern(Name).RestorePattern();
 			}
 		}
 		virtual void ProcessMap(std::string_view Name, std::string_view File, std::string_view TileSet, [[maybe_unused]] std::string_view Compression, [[maybe_unused]] const uint32_t Mapbase) override {
 			if (!empty(File)) {
-				auto Image = cv::imread(data(File));
-				std::cout << "[ Output Map ] " << Name << " (" << File << ")" << std::endl;
+				const auto Image = ReadImage(File);
+				Console::Out() << "[ Output Map ] " << Name << " (" << File << ")" << std::endl;
 
-				BG::Converter<>(Image).Create().OutputMap(Name).RestoreMap();
+				BG::Converter<>(Image).CreateIncremental(Name, [&]() { return Converted.Get<BG::Converter<>>(Image, File); }).OutputMap(Name).RestoreMap();
 			}
 		}
 		virtual void ProcessSprite(std::string_view Name, std::string_view File, const uint32_t Width, const uint32_t Height, [[maybe_unused]] std::string_view Compression, [[maybe_unused]] const uint32_t Time, [[maybe_unused]] std::string_view Collision, [[maybe_unused]] std::string_view Option, [[maybe_unused]] const uint32_t Iteration) override {
 			if (!empty(File)) {
-				auto Image = cv::imread(data(File));
-				std::cout << "[ Output Sprite ] " << Name << " (" << File << ")" << std::endl;
+				Console::Out() << "[ Output Sprite ] " << Name << " (" << File << ")" << std::endl;
+				const auto Image = ReadImage(File);
 
-				//!< 8x8 or 8x16
-				switch (Width << 3)
-				{
-				case 8:
-					switch (Height << 3) {
-					case 8:
-						Sprite::Converter<8, 8>(Image).Create().OutputPattern(Name).OutputAnimation(Name).RestorePattern();
-						break;
-					case 16:
-						Sprite::Converter<8, 16>(Image).Create().OutputPattern(Name).OutputAnimation(Name).RestorePattern();
-						break;
-					default:
-						std::cerr << "Sprite size not supported" << std::endl;
-						break;
+				static constexpr auto Kernels = CreateSpriteKernels<ResourceReader>();
+				ProcessSpriteKernel(Kernels, Image, Name, Width << 3, Height << 3);
+			}
+		}
+
+		//!< 8x8 or 8x16
+		static constexpr std::array<std::pair<uint8_t, uint8_t>, 2> SpriteSizes = { { { 8, 8 }, { 8, 16 } } };
+		template<uint8_t W, uint8_t H>
+		static void ConvertSprite(const cv::Mat& Image, std::string_view Name) {
+			Sprite::Converter<W, H>(Image).Create().OutputPattern(Name).OutputAnimation(Name).RestorePattern();
+		}
+
+		//!< }bv (u8) + p^[ (8 x 8A2 v[sɌ) + pbg (2 rbg x 4 F) 畜
+		virtual VERIFY VerifyMap(const VerifyEntry& Ent) const override {
+			if ("MAP" != Ent.Type) { return VerifySkip("Not supported on this platform"); }
+			if (empty(Ent.Palette)) { return VerifySkip("No PALETTE entry for " + Ent.File); }
+			std::vector<uint8_t> Pal, Words, Map;
+			if (!ReadBin(Ent.Palette, Pal)) { return VerifyFail("Cannot read " + Ent.Palette + ".bin"); }
+			if (!ReadBin(Ent.TileSet, Words)) { return VerifyFail("Cannot read " + Ent.TileSet + ".bin"); }
+			if (!ReadBin(Ent.Name, Map)) { return VerifyFail("Cannot read " + Ent.Name + ".bin"); }
+
+			const auto Image = ReadImage(Ent.File);
+			constexpr auto TileSize = 8;
+			constexpr auto BytesPerPattern = static_cast<size_t>(TileSize * 2);
+			const cv::Size MapSize(Image.cols / TileSize, Image.rows / TileSize);
+			if (size(Map) != static_cast<size_t>(MapSize.area())) { return VerifyFail("Map size does not match " + Ent.File); }
+
+			//!< BG ̃pbg 1 
+			const auto PalMask = Pal[0];
+			const cv::Size Size(MapSize.width * TileSize, MapSize.height * TileSize);
+			std::vector<uint16_t> Plane(static_cast<size_t>(Size.area()));
+			for (auto r = 0; r < MapSize.height; ++r) {
+				for (auto c = 0; c < MapSize.width; ++c) {
+					const auto PatIdx = Map[static_cast<size_t>(r) * MapSize.width + c];
+					if ((PatIdx + 1) * BytesPerPattern > size(Words)) { return VerifyFail("Pattern index out of range"); }
+					const auto Tile = &Words[PatIdx * BytesPerPattern];
+					for (auto y = 0; y < TileSize; ++y) {
+						for (auto x = 0; x < TileSize; ++x) {
+							const auto Bit = 7 - x;
+							const auto Index = ((Tile[y * 2 + 0] >> Bit) & 1) | (((Tile[y * 2 + 1] >> Bit) & 1) << 1);
+							Plane[static_cast<size_t>(r * TileSize + y) * Size.width + c * TileSize + x] = (PalMask >> (Index << 1)) & 0x3;
+						}
 					}
-					break;
-				default:
-					std::cerr << "Sprite size not supported" << std::endl;
-					break;
 				}
 			}
+			return Compare<Traits>(Image, Size, Plane);
 		}
 	};
 }
 #pragma endregion //!< GB
 
+#pragma region BENCHMARK
+namespace Benchmark
+{
+	//!<  (~b)
+	template<typename T>
+	static double Measure(T Func) {
+		const auto Begin = std::chrono::steady_clock::now();
+		Func();
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Begin).count();
+	}
+
+	//!< v (JSON ֏o͂)
+	struct Result
+	{
+		std::string Converter;
+		std::string Image;
+		cv::Size Size;
+		std::string Stage;
+		double Milliseconds = 0.0;
+	};
+	//!< eiK񂩌včŏl̂
+	constexpr auto RepeatCount = 3;
+
+	//!< 摜
+	struct SyntheticImage
+	{
+		std::string Name;
+		cv::Mat Image;
+	};
+	//!< sNZɃ_
+	static SyntheticImage CreateRandom(const cv::Size& Size) {
+		SyntheticImage Img({ .Name = "random", .Image = cv::Mat(Size, CV_8UC3) });
+		std::mt19937 Rnd(1);
+		for (auto i = 0; i < Size.height; ++i) {
+			std::ranges::generate(Img.Image.ptr<cv::Vec3b>(i), Img.Image.ptr<cv::Vec3b>(i) + Size.width, [&]() { const auto r = Rnd(); return cv::Vec3b(r & 0xff, (r >> 8) & 0xff, (r >> 16) & 0xff); });
+		}
+		return Img;
+	}
+	//!< ̃^C (8 x 8AF) ̌JԂAName ςđ傫ȃ}bvɂg
+	static SyntheticImage CreateRepetitive(std::string_view Name, const cv::Size& Size, const uint32_t TileCount) {
+		SyntheticImage Img({ .Name = std::string(Name), .Image = cv::Mat(Size, CV_8UC3) });
+		std::mt19937 Rnd(2);
+		constexpr std::array<uint8_t, 4> Levels = { 0x00, 0x60, 0xa0, 0xe0 };
+		std::vector<std::array<cv::Vec3b, 64>> Tiles(TileCount);
+		for (auto& i : Tiles) {
+			const std::array<cv::Vec3b, 3> Colors = { cv::Vec3b(Levels[Rnd() & 3], Levels[Rnd() & 3], Levels[Rnd() & 3]), cv::Vec3b(Levels[Rnd() & 3], Levels[Rnd() & 3], Levels[Rnd() & 3]), cv::Vec3b(Levels[Rnd() & 3], Levels[Rnd() & 3], Levels[Rnd() & 3]) };
+			std::ranges::generate(i, [&]() { return Colors[Rnd() % size(Colors)]; });
+		}
+		for (auto y = 0; y < Size.height; y += 8) {
+			for (auto x = 0; x < Size.width; x += 8) {
+				const auto& Tile = Tiles[Rnd() % TileCount];
+				for (auto i = 0; i < 8; ++i) {
+					std::ranges::copy(&Tile[i * 8], &Tile[i * 8] + 8, &Img.Image.ptr<cv::Vec3b>(y + i)[x]);
+				}
+			}
+		}
+		return Img;
+	}
+	//!< ʐ^ (Ȃ炩ȃOf[VɃmCY)
+	static SyntheticImage CreatePhotoLike(const cv::Size& Size) {
+		SyntheticImage Img({ .Name = "photo", .Image = cv::Mat(Size, CV_8UC3) });
+		std::mt19937 Rnd(3);
+		std::normal_distribution<float> Noise(0.0f, 6.0f);
+		const auto Clamp = [](const float rhs) { return static_cast<uint8_t>(std::clamp(rhs, 0.0f, 255.0f)); };
+		for (auto i = 0; i < Size.height; ++i) {
+			for (auto j = 0; j < Size.width; ++j) {
+				const auto u = static_cast<float>(j) / Size.width, v = static_cast<float>(i) / Size.height;
+				Img.Image.ptr<cv::Vec3b>(i)[j] = cv::Vec3b(Clamp(255.0f * u + Noise(Rnd)), Clamp(128.0f + 100.0f * std::sin(6.0f * u + 4.0f * v) + Noise(Rnd)), Clamp(255.0f * v + Noise(Rnd)));
+			}
+		}
+		return Img;
+	}
+
+	//!< ϊ T  CreateMap, CreatePalette, CreatePattern, e Output* v
+	template<typename T>
+	static void Pipeline(std::vector<Result>& Results, std::string_view Name, const SyntheticImage& Img, const std::vector<std::pair<std::string_view, std::function<void(const T&)>>>& Outputs) {
+		std::vector<std::pair<std::string, double>> Stages = { { "CreateMap", 0.0 }, { "CreatePalette", 0.0 }, { "CreatePattern", 0.0 } };
+		for (const auto& i : Outputs) {
+			Stages.emplace_back(std::string(i.first), 0.0);
+		}
+		for (auto& i : Stages) {
+			i.second = std::numeric_limits<double>::max();
+		}
+		for (auto r = 0; r < RepeatCount; ++r) {
+			T Conv(Img.Image);
+			const std::array<double, 3> Create = { Measure([&]() { Conv.CreateMap(); }), Measure([&]() { Conv.CreatePalette(); }), Measure([&]() { Conv.CreatePattern(); }) };
+			for (auto i = 0; i < size(Create); ++i) {
+				Stages[i].second = (std::min)(Stages[i].second, Create[i]);
+			}
+			for (auto i = 0; i < size(Outputs); ++i) {
+				Stages[size(Create) + i].second = (std::min)(Stages[size(Create) + i].second, Measure([&]() { Outputs[i].second(Conv); }));
+			}
+		}
+
+		std::cout << "[ Pipeline ] " << Name << " (" << Img.Name << " " << Img.Image.cols << " x " << Img.Image.rows << ")" << std::endl;
+		for (const auto& i : Stages) {
+			std::cout << "\t" << i.first << " = " << i.second << " ms" << std::endl;
+			Results.emplace_back(Result({ .Converter = std::string(Name), .Image = Img.Name, .Size = Img.Image.size(), .Stage = i.first, .Milliseconds = i.second }));
+		}
+	}
+
+	template<uint8_t W, uint8_t H>
+	static void PCESprite(std::vector<Result>& Results, const SyntheticImage& Img) {
+		using T = PCE::Sprite::Converter<W, H>;
+		Pipeline<T>(Results, "PCE::Sprite<" + std::to_string(W) + "x" + std::to_string(H) + ">", Img, {
+			{ "OutputPattern", [](const T& rhs) { rhs.OutputPattern("bench"); } },
+			{ "OutputPatternPalette", [](const T& rhs) { rhs.OutputPatternPalette("bench"); } },
+			{ "OutputAnimation", [](const T& rhs) { rhs.OutputAnimation("bench"); } },
+		});
+	}
+
+	//!< F (1 pbgɎ܂F)
+	template<typename T>
+	static void ReduceColor(std::vector<Result>& Results, std::string_view Name, const SyntheticImage& Img) {
+		auto Milliseconds = (std::numeric_limits<double>::max)();
+		for (auto r = 0; r < RepeatCount; ++r) {
+			T Conv(Img.Image);
+			Milliseconds = (std::min)(Milliseconds, Measure([&]() { Conv.ReduceColor(Conv.GetPaletteColorCount() - Conv.GetPaletteReservedColorCount()); }));
+		}
+		std::cout << "[ Reduce color ] " << Name << " (" << Img.Name << " " << Img.Image.cols << " x " << Img.Image.rows << ")" << std::endl;
+		std::cout << "\tReduceColor = " << Milliseconds << " ms" << std::endl;
+		Results.emplace_back(Result({ .Converter = std::string(Name), .Image = Img.Name, .Size = Img.Image.size(), .Stage = "ReduceColor", .Milliseconds = Milliseconds }));
+	}
+
+	//!< ԋ߂F̌𑍓ƃe[uŔr
+	template<size_t N>
+	static void NearestColor(std::vector<Result>& Results, std::string_view Name, const std::array<cv::Vec3b, N>& Entries, const NearestColorTable<N>& Table) {
+		std::cout << "[ Nearest color ] " << Name << std::endl;
+		const auto Build = Measure([&]() { const NearestColorTable<N> Tmp(Entries); });
+		std::cout << "\tBuild table = " << Build << " ms" << std::endl;
+
+		//!< SFőƈv邩
+		uint32_t Mismatch = 0;
+		for (uint32_t i = 0; i < (1 << 24); ++i) {
+			const cv::Vec3b Color(i & 0xff, (i >> 8) & 0xff, (i >> 16) & 0xff);
+			if (Table.Find(Color) != NearestColorTable<N>::FindLinear(Entries, Color)) { ++Mismatch; }
+		}
+		std::cout << "\tMismatch = " << Mismatch << " / " << (1 << 24) << std::endl;
+
+		//!< _ȐFŌv
+		std::vector<cv::Vec3b> Colors(1 << 22);
+		std::mt19937 Rnd(0);
+		std::ranges::generate(Colors, [&]() { const auto r = Rnd(); return cv::Vec3b(r & 0xff, (r >> 8) & 0xff, (r >> 16) & 0xff); });
+		volatile uint32_t Sink = 0;
+		const auto Linear = Measure([&]() { uint32_t Sum = 0; for (const auto& i : Colors) { Sum += NearestColorTable<N>::FindLinear(Entries, i); } Sink = Sum; });
+		const auto Tbl = Measure([&]() { uint32_t Sum = 0; for (const auto& i : Colors) { Sum += Table.Find(i); } Sink = Sum; });
+		std::cout << "\tLinear = " << Linear << " ms, Table = " << Tbl << " ms (x" << Linear / Tbl << ") / " << size(Colors) << " pixels" << std::endl;
+
+		const auto Size = cv::Size(static_cast<int>(size(Colors)), 1);
+		Results.emplace_back(Result({ .Converter = std::string(Name), .Image = "nearest-color", .Size = Size, .Stage = "BuildTable", .Milliseconds = Build }));
+		Results.emplace_back(Result({ .Converter = std::string(Name), .Image = "nearest-color", .Size = Size, .Stage = "FindLinear", .Milliseconds = Linear }));
+		Results.emplace_back(Result({ .Converter = std::string(Name), .Image = "nearest-color", .Size = Size, .Stage = "FindTable", .Milliseconds = Tbl }));
+	}
+
+	static void WriteJSON(std::string_view Path, const std::vector<Result>& Results) {
+		std::stringstream SS;
+		SS << "{\n\t\"version\": " << BuildManifest::ConverterVersion << ",\n\t\"results\": [\n";
+		for (auto i = 0; i < size(Results); ++i) {
+			const auto& R = Results[i];
+			SS << "\t\t{ \"converter\": \"" << R.Converter << "\", \"image\": \"" << R.Image << "\", \"width\": " << R.Size.width << ", \"height\": " << R.Size.height << ", \"stage\": \"" << R.Stage << "\", \"ms\": " << R.Milliseconds << " }" << (size(Results) - 1 > i ? "," : "") << "\n";
+		}
+		SS << "\t]\n}\n";
+		std::ofstream Out(data(std::string(Path)), std::ios::out);
+		Out << SS.str();
+		std::cout << "Results : " << std::filesystem::absolute(Path).string() << std::endl;
+	}
+
+	//!< ʂ JSON  Path ֏o
+	static void Run(std::string_view Path) {
+		std::vector<Result> Results;
+
+		NearestColor(Results, "FC", FC::ColorEntries, FC::GetColorTable());
+		NearestColor(Results, "GB", GB::ColorEntries, GB::GetColorTable());
+
+		const std::vector<SyntheticImage> Images = {
+			CreateRandom(cv::Size(128, 128)),
+			CreateRepetitive("repetitive", cv::Size(512, 512), 64),
+			CreatePhotoLike(cv::Size(256, 256)),
+			CreateRepetitive("large-map", cv::Size(2048, 2048), 256),
+		};
+
+		{
+			//!< o̓t@C͈ꎞfBNgցAR\[o͎͂̂Ă
+			const auto Current = std::filesystem::current_path();
+			const auto Temp = std::filesystem::temp_directory_path() / "ImageConverter.bench";
+			std::filesystem::create_directories(Temp);
+			std::filesystem::current_path(Temp);
+			//!< OŔꍇJgfBNg߂AꎞfBNg
+			const ScopeExit RestorePath([&]() {
+				std::error_code EC;
+				std::filesystem::current_path(Current, EC);
+				std::filesystem::remove_all(Temp, EC);
+			});
+			std::ostringstream Null;
+			const auto PrevOut = Console::OutStream, PrevErr = Console::ErrStream;
+			Console::OutStream = Console::ErrStream = &Null;
+			//!< Null jOɃR\[o͐߂
+			const ScopeExit RestoreConsole([&]() {
+				Console::OutStream = PrevOut;
+				Console::ErrStream = PrevErr;
+			});
+
+			for (const auto& Img : Images) {
+				{
+					using T = PCE::BG::Converter<>;
+					Pipeline<T>(Results, "PCE::BG", Img, {
+						{ "OutputPalette", [](const T& rhs) { rhs.OutputPalette("bench"); } },
+						{ "OutputPattern", [](const T& rhs) { rhs.OutputPattern("bench"); } },
+						{ "OutputPatternPalette", [](const T& rhs) { rhs.OutputPatternPalette("bench"); } },
+						{ "OutputMap", [](const T& rhs) { rhs.OutputMap("bench"); } },
+					});
+					ReduceColor<T>(Results, "PCE::BG", Img);
+				}
+				{
+					using T = PCE::Image::Converter<>;
+					Pipeline<T>(Results, "PCE::Image", Img, {
+						{ "OutputPattern", [](const T& rhs) { rhs.OutputPattern("bench"); } },
+						{ "OutputBAT", [](const T& rhs) { rhs.OutputBAT("bench"); } },
+					});
+				}
+				//!< XvCg͑傫ȃ}bvł͌vȂ (p^[ČIłȂ)
+				if (Img.Image.total() <= 512 * 512) {
+					PCESprite<16, 16>(Results, Img);
+					PCESprite<32, 32>(Results, Img);
+					PCESprite<32, 64>(Results, Img);
+				}
+				{
+					using T = FC::BG::Converter<>;
+					Pipeline<T>(Results, "FC::BG", Img, {
+						{ "OutputPalette", [](const T& rhs) { rhs.OutputPalette("bench"); } },
+						{ "OutputPattern", [](const T& rhs) { rhs.OutputPattern("bench"); } },
+						{ "OutputBAT", [](const T& rhs) { rhs.OutputBAT("bench"); } },
+					});
+					ReduceColor<T>(Results, "FC::BG", Img);
+				}
+				{
+					using T = GB::BG::Converter<>;
+					Pipeline<T>(Results, "GB::BG", Img, {
+						{ "OutputPalette", [](const T& rhs) { rhs.OutputPalette("bench"); } },
+						{ "OutputPattern", [](const T& rhs) { rhs.OutputPattern("bench"); } },
+						{ "OutputMap", [](const T& rhs) { rhs.OutputMap("bench"); } },
+					});
+				}
+				Null.str("");
+			}
+		}
+
+		WriteJSON(Path, Results);
+	}
+}
+#pragma endregion //!< BENCHMARK
+
 int main(const int argc, const char *argv[])
 {
 	enum PLATFORM {
@@ -1713,13 +4242,51 @@ int main(const int argc, const char *argv[])
 	}
 #endif
 
-	if (2 < argc) {
-		Path = argv[2];
+	//!< --jobs N (-j N), --rebuild, --watch, --verify, --trace FILE, --cache MB 菜̂Ƃ
+	uint32_t JobCount = 1;
+	auto Rebuild = false;
+	auto Watch = false;
+	auto Verify = false;
+	std::vector<std::string_view> Args;
+	for (auto i = 0; i < argc; ++i) {
+		const std::string_view Arg(argv[i]);
+		if (("--jobs" == Arg || "-j" == Arg) && i + 1 < argc) {
+			const std::string_view Value(argv[++i]);
+			auto [ptr, ec] = std::from_chars(data(Value), data(Value) + size(Value), JobCount);
+			if (std::errc() != ec) {}
+		}
+		else if ("--rebuild" == Arg) {
+			Rebuild = true;
+		}
+		else if ("--watch" == Arg) {
+			Watch = true;
+		}
+		else if ("--verify" == Arg) {
+			Verify = true;
+		}
+		else if ("--trace" == Arg && i + 1 < argc) {
+			Trace::Enable(argv[++i]);
+		}
+		else if ("--cache" == Arg && i + 1 < argc) {
+			const std::string_view Value(argv[++i]);
+			size_t MegaBytes = 0;
+			auto [ptr, ec] = std::from_chars(data(Value), data(Value) + size(Value), MegaBytes);
+			if (std::errc() == ec) {
+				ImageCache::Instance().SetCapacity(MegaBytes << 20);
+			}
+		}
+		else {
+			Args.emplace_back(Arg);
+		}
+	}
+
+	if (2 < size(Args)) {
+		Path = Args[2];
 	}
 	std::cout << Path << std::endl;
-	if (1 < argc) {
+	if (1 < size(Args)) {
 		std::string Option;
-		std::ranges::transform(std::string_view(argv[1]), std::back_inserter(Option), [](const char rhs) { return std::toupper(rhs, std::locale("")); });
+		std::ranges::transform(Args[1], std::back_inserter(Option), [](const char rhs) { return std::toupper(rhs, std::locale("")); });
 
 		//!< C++23 Ȃ contains() g݂
 		if (std::string_view::npos != Option.find("PCE")) {
@@ -1727,53 +4294,60 @@ int main(const int argc, const char *argv[])
 		}
 		else if (std::string_view::npos != Option.find("FC")) {
 			Platform = FC;
-			FC::ResourceReader rr;
-			rr.Read(Path);
 		}
 		else if (std::string_view::npos != Option.find("GBC") || std::string_view::npos != Option.find("CGB")) {
 			Platform = GBC;
-			//GBC::ResourceReader rr;
-			//rr.Read(Path);
 		}
 		else if (std::string_view::npos != Option.find("GB")) {
 			Platform = GB;
-			GB::ResourceReader rr;
-			rr.Read(Path);
+		}
+		else if (std::string_view::npos != Option.find("BENCH")) {
+			Benchmark::Run(2 < size(Args) ? Args[2] : "benchmark.json");
+			return 0;
 		}
 		else if (std::string_view::npos != Option.find("HELP")) {
-			std::cout << "Usage : " << std::filesystem::path(argv[0]).filename().string() << " " << "[Platform]" << " " << "[Resource folder]" << std::endl;
+			std::cout << "Usage : " << std::filesystem::path(Args[0]).filename().string() << " " << "[Platform]" << " " << "[Resource folder]" << " " << "[--jobs N]" << " " << "[--rebuild]" << " " << "[--watch]" << " " << "[--verify]" << " " << "[--trace FILE]" << " " << "[--cache MB]" << std::endl;
 			std::cout << "\tPlatform : PCE, FC, GB, CGB(GBC)" << std::endl;
+			std::cout << "\t--jobs N : Number of worker threads (0 = hardware concurrency, default 1)" << std::endl;
+			std::cout << "\t--rebuild : Ignore the build manifest and convert every entry" << std::endl;
+			std::cout << "\t--watch : Keep running and reconvert when .res files or their images change" << std::endl;
+			std::cout << "\t--verify : Rebuild each map from the output .bin files, compare it with the source image and exit with 1 on mismatch" << std::endl;
+			std::cout << "\t--trace FILE : Write per-entry and per-stage timings as Chrome trace JSON (Perfetto)" << std::endl;
+			std::cout << "\t--cache MB : Decoded image cache size (default 1024)" << std::endl;
+			std::cout << "Usage : " << std::filesystem::path(Args[0]).filename().string() << " " << "BENCH" << " " << "[Result JSON (default benchmark.json)]" << std::endl;
 
 			return 0;
 		}
 	}
+	//!< ϊA--verify Ȃo͂؂Asv 1 Ԃ
+	const auto Process = [&](ResourceReaderBase& rr) {
+		Watch ? rr.Watch(Path, JobCount, Rebuild) : rr.Read(Path, JobCount, Rebuild);
+		return Verify && !rr.Verify(JobCount) ? 1 : 0;
+	};
 	switch (Platform) {
 	case PCE:
 	{
 		std::cout << "Platform : PCE" << std::endl;
 		PCE::ResourceReader rr;
-		rr.Read(Path);
+		return Process(rr);
 	}
-		break;
 	case FC:
 	{
 		std::cout << "Platform : FC" << std::endl;
 		FC::ResourceReader rr;
-		rr.Read(Path);
+		return Process(rr);
 	}
-	break;
 	case GB:
 	{
 		std::cout << "Platform : GB" << std::endl;
 		GB::ResourceReader rr;
-		rr.Read(Path);
+		return Process(rr);
 	}
-	break;
 	case GBC:
 	{
 		std::cout << "Platform : CGB(GBC)" << std::endl;
 		//GBC::ResourceReader rr;
-		//rr.Read(Path);
+		//Watch ? rr.Watch(Path, JobCount, Rebuild) : rr.Read(Path, JobCount, Rebuild);
 	}
 	break;
 	default: